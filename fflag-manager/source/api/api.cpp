@@ -0,0 +1,248 @@
+#include "odessa.h"
+
+// local->misc
+#include "logger/logger.hpp"
+
+// local->engine
+#include "session/session.hpp"
+
+static_assert( static_cast< int >( odessa::engine::e_apply_status::failed ) == ODESSA_WRITE_FAILED,
+               "per flag statuses are handed out as odessa_status_t unchanged" );
+
+struct odessa_handle
+{
+    odessa::engine::c_session session; ///< The client the handle is attached to and its caches
+};
+
+namespace
+{
+    std::mutex  g_handles_mutex;         ///< Guards the handle count and the shared logger
+    std::size_t g_handles { 0 };         ///< Handles that have not been destroyed yet
+    bool        g_owns_logger { false }; ///< Whether g_logger was created by the library and has to be stopped by it
+
+    /**
+     * @brief Turns a flag or value array into engine entries.
+     */
+    template < typename type_t >
+    std::vector< odessa::engine::entry_t > make_entries( const type_t *flags, std::size_t count )
+    {
+        std::vector< odessa::engine::entry_t > entries;
+        entries.reserve( count );
+
+        for ( std::size_t idx = 0; idx < count; ++idx )
+        {
+            nlohmann::json value;
+
+            if constexpr ( std::is_same_v< type_t, odessa_flag_t > )
+            {
+                if ( flags[ idx ].value )
+                    value = std::string( flags[ idx ].value );
+            }
+
+            entries.push_back( odessa::engine::make_entry( flags[ idx ].key ? flags[ idx ].key : "", std::move( value ) ) );
+        }
+
+        return entries;
+    }
+
+    /**
+     * @brief Maps why a session call did not go through to the status handed out.
+     */
+    odessa_status_t convert( odessa::engine::e_call_status status )
+    {
+        switch ( status )
+        {
+            case odessa::engine::e_call_status::ok:
+                return ODESSA_OK;
+            case odessa::engine::e_call_status::not_ready:
+                return ODESSA_NOT_READY;
+            default:
+                return ODESSA_NOT_ATTACHED;
+        }
+    }
+
+    /**
+     * @brief Reports an exception that would otherwise cross the C ABI.
+     */
+    odessa_status_t fail( std::string_view call, const std::exception &eggsception ) noexcept
+    {
+        if ( odessa::g_logger )
+            odessa::g_logger->error( "{} failed: {}", call, eggsception.what( ) );
+
+        return ODESSA_INTERNAL_ERROR;
+    }
+
+    /**
+     * @brief Checks the arguments every batch call shares.
+     */
+    odessa_status_t check( const odessa_handle_t *handle, const void *flags, std::size_t count )
+    {
+        if ( !handle or ( !flags and count ) )
+            return ODESSA_INVALID_ARGUMENT;
+
+        return handle->session.attached( ) ? ODESSA_OK : ODESSA_NOT_ATTACHED;
+    }
+} // namespace
+
+extern "C"
+{
+    uint32_t odessa_version( void )
+    {
+        return ODESSA_API_VERSION;
+    }
+
+    odessa_handle_t *odessa_create( const char *log_path )
+    {
+        try
+        {
+            std::scoped_lock lock( g_handles_mutex );
+
+            auto handle = std::make_unique< odessa_handle_t >( );
+
+            if ( !g_handles and !odessa::g_logger )
+            {
+                const odessa::log_config_t config { .console = false, .json_path = log_path ? log_path : "" };
+
+                odessa::g_logger = std::make_unique< odessa::c_logger >( config );
+                g_owns_logger    = true;
+            }
+
+            // only counted once nothing can fail anymore
+            ++g_handles;
+            return handle.release( );
+        }
+        catch ( const std::exception &eggsception )
+        {
+            static_cast< void >( fail( "odessa_create", eggsception ) );
+            return nullptr;
+        }
+    }
+
+    void odessa_destroy( odessa_handle_t *handle )
+    {
+        if ( !handle )
+            return;
+
+        delete handle;
+
+        try
+        {
+            std::scoped_lock lock( g_handles_mutex );
+
+            // the consumer thread has to be joined here, joining it from the DLL's static destructors deadlocks on the loader lock
+            if ( !--g_handles and g_owns_logger )
+            {
+                odessa::g_logger.reset( );
+                g_owns_logger = false;
+            }
+        }
+        catch ( const std::exception &eggsception )
+        {
+            // the handle is released either way, only the logger is left running
+            static_cast< void >( fail( "odessa_destroy", eggsception ) );
+        }
+    }
+
+    odessa_status_t odessa_attach( odessa_handle_t *handle, uint32_t timeout_ms )
+    {
+        if ( !handle )
+            return ODESSA_INVALID_ARGUMENT;
+
+        const auto timeout = timeout_ms == ODESSA_WAIT_FOREVER ? odessa::c_target::forever : std::chrono::milliseconds( timeout_ms );
+
+        switch ( handle->session.attach( timeout ) )
+        {
+            case odessa::engine::e_attach_status::ok:
+                return ODESSA_OK;
+            case odessa::engine::e_attach_status::not_found:
+                return ODESSA_NOT_FOUND;
+            default:
+                return ODESSA_NO_TABLE;
+        }
+    }
+
+    odessa_status_t odessa_resolve( odessa_handle_t *handle, odessa_flag_t *flags, size_t count )
+    {
+        if ( const auto status = check( handle, flags, count ); status != ODESSA_OK )
+            return status;
+
+        try
+        {
+            std::vector< odessa::engine::e_apply_status > statuses;
+
+            if ( const auto status = convert( handle->session.resolve( make_entries( flags, count ), statuses ) ); status != ODESSA_OK )
+                return status;
+
+            for ( std::size_t idx = 0; idx < count; ++idx )
+                flags[ idx ].status = static_cast< odessa_status_t >( statuses[ idx ] );
+
+            return ODESSA_OK;
+        }
+        catch ( const std::exception &eggsception )
+        {
+            return fail( "odessa_resolve", eggsception );
+        }
+    }
+
+    odessa_status_t odessa_apply( odessa_handle_t *handle, odessa_flag_t *flags, size_t count )
+    {
+        if ( const auto status = check( handle, flags, count ); status != ODESSA_OK )
+            return status;
+
+        try
+        {
+            std::vector< odessa::engine::e_apply_status > statuses;
+
+            if ( const auto status = convert( handle->session.apply( make_entries( flags, count ), statuses ) ); status != ODESSA_OK )
+                return status;
+
+            for ( std::size_t idx = 0; idx < count; ++idx )
+                flags[ idx ].status = static_cast< odessa_status_t >( statuses[ idx ] );
+
+            return ODESSA_OK;
+        }
+        catch ( const std::exception &eggsception )
+        {
+            return fail( "odessa_apply", eggsception );
+        }
+    }
+
+    odessa_status_t odessa_snapshot( odessa_handle_t *handle, odessa_value_t *values, size_t count )
+    {
+        if ( const auto status = check( handle, values, count ); status != ODESSA_OK )
+            return status;
+
+        try
+        {
+            std::vector< std::optional< std::string > > snapshot;
+
+            if ( const auto status = convert( handle->session.snapshot( make_entries( values, count ), snapshot ) ); status != ODESSA_OK )
+                return status;
+
+            for ( std::size_t idx = 0; idx < count; ++idx )
+            {
+                auto       &value   = values[ idx ];
+                const auto &current = snapshot[ idx ];
+
+                const auto bytes = current ? std::min( current->size( ), sizeof( value.value ) - 1 ) : 0;
+                if ( current )
+                    std::memcpy( value.value, current->data( ), bytes );
+
+                value.value[ bytes ] = '\0';
+                value.status         = current ? ODESSA_OK : ODESSA_MISSING;
+            }
+
+            return ODESSA_OK;
+        }
+        catch ( const std::exception &eggsception )
+        {
+            return fail( "odessa_snapshot", eggsception );
+        }
+    }
+
+    void odessa_detach( odessa_handle_t *handle )
+    {
+        if ( handle )
+            handle->session.detach( );
+    }
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+/*
+ * C API of the FFlag manager, for launchers that link it instead of spawning odessa.exe.
+ *
+ * A handle attaches to one client at a time and keeps every FFlag it resolved, so repeated applies to the same
+ * client only write. Detaching keeps the offsets learned for the client build, attaching to a relaunched client
+ * of the same build is warm. Calls on different handles are serialized. No call lets a C++ exception escape.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined( ODESSA_SHARED ) && defined( _WIN32 )
+#ifdef ODESSA_EXPORTS
+#define ODESSA_API __declspec( dllexport )
+#else
+#define ODESSA_API __declspec( dllimport )
+#endif
+#else
+#define ODESSA_API
+#endif
+
+#define ODESSA_API_VERSION 2           /**< Bumped whenever a declaration below changes incompatibly */
+#define ODESSA_VALUE_CAPACITY 256      /**< Size of odessa_value_t::value, including the terminator */
+#define ODESSA_WAIT_FOREVER UINT32_MAX /**< Timeout of odessa_attach() that never gives up */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef enum odessa_status
+    {
+        ODESSA_OK               = 0, /**< Success */
+        ODESSA_MISSING          = 1, /**< The FFlag does not exist in the client */
+        ODESSA_UNREGISTERED     = 2, /**< The FFlag's GetSet was never registered, it cannot be written */
+        ODESSA_INVALID_VALUE    = 3, /**< The value could not be converted to the FFlag's type */
+        ODESSA_WRITE_FAILED     = 4, /**< The write to the client failed */
+        ODESSA_NOT_ATTACHED     = 5, /**< The handle is not attached to a client, or the client exited */
+        ODESSA_NO_TABLE         = 6, /**< The client was found but its FFlag table was not */
+        ODESSA_INVALID_ARGUMENT = 7, /**< A pointer argument was null */
+        ODESSA_NOT_FOUND        = 8, /**< The client was not running before the timeout */
+        ODESSA_NOT_READY        = 9, /**< The client did not populate its FFlag table in time, try again later */
+        ODESSA_INTERNAL_ERROR   = 10 /**< The library failed internally, e.g. ran out of memory, before touching the client */
+    } odessa_status_t;
+
+    typedef struct odessa_flag
+    {
+        const char     *key;    /**< Key as written in fflags.json, e.g. "DFIntTaskSchedulerTargetFps" */
+        const char     *value;  /**< Value as written in fflags.json, e.g. "144", "True" or "info" */
+        odessa_status_t status; /**< Filled in per flag */
+    } odessa_flag_t;
+
+    typedef struct odessa_value
+    {
+        const char     *key;                           /**< Key as written in fflags.json */
+        char            value[ ODESSA_VALUE_CAPACITY ]; /**< Filled in with the current value, truncated if needed */
+        odessa_status_t status;                        /**< Filled in per flag, ODESSA_OK or ODESSA_MISSING */
+    } odessa_value_t;
+
+    typedef struct odessa_handle odessa_handle_t;
+
+    /**
+     * @brief Returns the API version the library was built with, see ODESSA_API_VERSION.
+     */
+    ODESSA_API uint32_t odessa_version( void );
+
+    /**
+     * @brief Creates a handle. The library never writes to the console.
+     *
+     * @param log_path A file receiving every log record as JSON lines, or NULL. Only used if no other handle exists.
+     *
+     * @return The handle, release it with odessa_destroy(), or NULL if it could not be created. Destroy every handle
+     *         before unloading the library.
+     */
+    ODESSA_API odessa_handle_t *odessa_create( const char *log_path );
+
+    /**
+     * @brief Detaches and releases a handle. Destroying the last handle also stops the library's logging thread.
+     */
+    ODESSA_API void odessa_destroy( odessa_handle_t *handle );
+
+    /**
+     * @brief Waits for the client to run and attaches to it, detaching from any previous instance first.
+     *
+     * Calls on other handles are not held up while this waits for the client.
+     *
+     * @param timeout_ms How long to wait for the client, 0 to only check, ODESSA_WAIT_FOREVER to never give up.
+     *
+     * @return ODESSA_OK, ODESSA_NOT_FOUND if the client did not appear in time, or ODESSA_NO_TABLE if its FFlag table
+     *         could not be located.
+     */
+    ODESSA_API odessa_status_t odessa_attach( odessa_handle_t *handle, uint32_t timeout_ms );
+
+    /**
+     * @brief Resolves FFlags ahead of odessa_apply(). Values are ignored.
+     *
+     * Batch calls wait a few seconds at most for a client that is still loading its FFlag table, then return
+     * ODESSA_NOT_READY without touching the per flag statuses. ODESSA_NOT_ATTACHED is returned once the client exited.
+     *
+     * @return ODESSA_OK once every flag has its status, even if some are missing.
+     */
+    ODESSA_API odessa_status_t odessa_resolve( odessa_handle_t *handle, odessa_flag_t *flags, size_t count );
+
+    /**
+     * @brief Writes a batch of flags. Flags resolved by earlier calls on the handle are not looked up again.
+     *
+     * @return ODESSA_OK once every flag has its status, even if some failed.
+     */
+    ODESSA_API odessa_status_t odessa_apply( odessa_handle_t *handle, odessa_flag_t *flags, size_t count );
+
+    /**
+     * @brief Reads the current values of a batch of flags.
+     *
+     * @return ODESSA_OK once every value has its status, even if some are missing.
+     */
+    ODESSA_API odessa_status_t odessa_snapshot( odessa_handle_t *handle, odessa_value_t *values, size_t count );
+
+    /**
+     * @brief Releases the attached client without waiting for it to exit. The handle can attach again.
+     */
+    ODESSA_API void odessa_detach( odessa_handle_t *handle );
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
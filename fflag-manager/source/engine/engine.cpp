@@ -1,7 +1,12 @@
 #include "engine.hpp"
 
-// vendor
-#include <nlohmann/json.hpp>
+// local->misc
+#include "logger/logger.hpp"
+
+// local->engine
+#include "journal/journal.hpp"
+#include "pending/pending.hpp"
+#include "supervisor/supervisor.hpp"
 
 // standard
 #include <iostream>
@@ -19,6 +24,21 @@ namespace odessa::engine
         {     "FLog",     { 4, e_value_type::log } }
     };
 
+    struct tier_t
+    {
+        std::vector< entry_t >     entries; ///< Entries of the tier, in fflags.json order
+        std::vector< std::string > names;   ///< FFlag names of the entries, in the same order
+    };
+
+    struct outcome_t
+    {
+        std::vector< entry_t > missing { }; ///< Entries whose FFlag was not found
+        std::size_t            failed { 0 }; ///< Entries that were not applied, including the missing ones
+        write_stats_t          writes { };   ///< Counters of the write plans
+    };
+
+    constexpr std::uint32_t default_tier { 1 }; ///< Tier of entries that do not specify one
+
     bool string_to_bool( const std::string &string )
     {
         if ( string.empty( ) )
@@ -69,77 +89,88 @@ namespace odessa::engine
         return std::stoi( string );
     }
 
-    void setup( )
+    bool load_fflags( nlohmann::json &data, std::map< std::uint32_t, tier_t > &tiers )
     {
         std::ifstream file( "fflags.json" );
         if ( !file.is_open( ) )
         {
-            std::println( "failed to find fflags.json (doesn't exist)" );
-            return;
+            g_logger->error( "failed to find fflags.json (doesn't exist)" );
+            return false;
         }
 
-        nlohmann::json data;
-
         try
         {
             file >> data;
         }
         catch ( const nlohmann::json::parse_error &eggsception )
         {
-            std::println( "failed to parse fflags.json: {}", eggsception.what( ) );
-            return;
+            g_logger->error( "failed to parse fflags.json: {}", eggsception.what( ) );
+            return false;
         };
 
-        std::vector< std::string > failed;
-
         for ( const auto &[ key, value ] : data.items( ) )
         {
-            e_value_type value_type { e_value_type::integer };
-            std::string  name { key };
-
-            bool prefix_found = false;
+            nlohmann::json setting = value;
+            std::uint32_t  tier    = default_tier;
 
-            for ( const auto &[ prefix, info ] : prefix_map )
+            // "DFIntTaskSchedulerTargetFps": { "value": 144, "tier": 0 } moves an entry to an earlier tier
+            if ( value.is_object( ) and value.contains( "value" ) )
             {
-                if ( key.starts_with( prefix ) )
-                {
-                    name         = key.substr( info.first );
-                    value_type   = info.second;
-                    prefix_found = true;
-                    break;
-                }
+                setting = value[ "value" ];
+
+                if ( value.contains( "tier" ) and value[ "tier" ].is_number_unsigned( ) )
+                    tier = value[ "tier" ].get< std::uint32_t >( );
             }
 
-            if ( name.empty( ) )
+            auto entry = make_entry( key, std::move( setting ) );
+            if ( entry.name.empty( ) )
                 continue;
 
-            const auto fflag = g_fflags->find( name );
-            if ( !fflag )
-            {
-                failed.emplace_back( key );
-                continue;
-            }
+            auto &group = tiers[ tier ];
 
-            if ( fflag->value == reinterpret_cast< void * >( 0x65757254 ) or fflag->value == reinterpret_cast< void * >( 0x31303031 ) )
+            group.names.push_back( entry.name );
+            group.entries.push_back( std::move( entry ) );
+        }
+
+        return true;
+    }
+
+    entry_t make_entry( const std::string &key, nlohmann::json value )
+    {
+        entry_t entry { .key = key, .name = key, .value_type = e_value_type::integer, .value = std::move( value ) };
+
+        for ( const auto &[ prefix, info ] : prefix_map )
+        {
+            if ( key.starts_with( prefix ) )
             {
-                std::println( "fflag [{}] has unregistered getset, skipping", name );
-                continue;
+                entry.name       = key.substr( info.first );
+                entry.value_type = info.second;
+                break;
             }
+        }
 
-            bool success = false;
+        return entry;
+    }
 
-            if ( value.is_boolean( ) )
-            {
-                const std::int32_t int_value = value.get< bool >( ) ? 1 : 0;
-                success                      = fflag.set( int_value );
+    e_apply_status stage_fflag( const entry_t &entry, const c_remote_fflag &fflag, c_write_planner &planner, std::size_t owner )
+    {
+        const auto &[ key, name, value_type, value ] = entry;
 
-                std::println( "{} -> {}", name, success );
-            }
+        if ( !fflag )
+            return e_apply_status::missing;
+
+        if ( !fflag.registered( ) )
+        {
+            g_logger->warning( "fflag [{}] has unregistered getset, skipping", name );
+            return e_apply_status::unregistered;
+        }
+
+        try
+        {
+            if ( value.is_boolean( ) )
+                planner.stage( owner, fflag, value.get< bool >( ) ? 1 : 0 );
             else if ( value.is_number_integer( ) )
-            {
-                success = fflag.set( value.get< std::int32_t >( ) );
-                std::println( "{} -> {}", name, success );
-            }
+                planner.stage( owner, fflag, value.get< std::int32_t >( ) );
             else if ( value.is_string( ) )
             {
                 const std::string str_value = value.get< std::string >( );
@@ -148,61 +179,274 @@ namespace odessa::engine
                 {
                     case e_value_type::flag :
                     {
-                        const std::int32_t int_value = string_to_bool( str_value ) ? 1 : 0;
-                        success                      = fflag.set( int_value );
+                        planner.stage( owner, fflag, string_to_bool( str_value ) ? 1 : 0 );
                         break;
                     }
                     case e_value_type::integer :
                     {
-                        success = fflag.set( std::stoi( str_value ) );
+                        planner.stage( owner, fflag, std::stoi( str_value ) );
                         break;
                     }
                     case e_value_type::string :
                     {
-                        success = fflag.set( str_value );
+                        planner.stage( owner, fflag, str_value );
                         break;
                     }
                     case e_value_type::log :
                     {
-                        success = fflag.set( level_to_integer( str_value ) );
+                        planner.stage( owner, fflag, level_to_integer( str_value ) );
                         break;
                     }
                     default :
                     {
-                        std::println( "can't determine type for {}", key );
-                        continue;
+                        g_logger->warning( "can't determine type for {}", key );
+                        return e_apply_status::invalid;
                     }
                 }
-
-                std::println( "{} -> {} | {:#x}", name, success, reinterpret_cast< std::uint64_t >( fflag->value ) );
             }
             else
-                std::println( "failed to parse type for key: {}", key );
+            {
+                g_logger->warning( "failed to parse type for key: {}", key );
+                return e_apply_status::invalid;
+            }
+        }
+        catch ( const std::exception &eggsception )
+        {
+            // std::stoi on a malformed string
+            g_logger->warning( "failed to convert the value of {}: {}", key, eggsception.what( ) );
+            return e_apply_status::invalid;
+        }
+
+        return e_apply_status::ok;
+    }
+
+    std::vector< e_apply_status > apply_batch( std::span< const entry_t > entries, std::span< const c_remote_fflag *const > fflags,
+                                               write_stats_t &stats )
+    {
+        std::vector< e_apply_status > statuses( entries.size( ), e_apply_status::missing );
+        c_write_planner               planner;
+
+        for ( std::size_t idx = 0; idx < entries.size( ); ++idx )
+        {
+            if ( fflags[ idx ] )
+                statuses[ idx ] = stage_fflag( entries[ idx ], *fflags[ idx ], planner, idx );
+        }
+
+        planner.commit( );
+        stats += planner.stats( );
+
+        for ( std::size_t idx = 0; idx < entries.size( ); ++idx )
+        {
+            if ( statuses[ idx ] != e_apply_status::ok )
+                continue;
+
+            const auto &entry   = entries[ idx ];
+            const bool  success = planner.written( idx );
+
+            if ( entry.value.is_string( ) )
+                g_logger->info( "{} -> {} | {:#x}", entry.name, success, reinterpret_cast< std::uint64_t >( ( *fflags[ idx ] )->value ) );
+            else
+                g_logger->info( "{} -> {}", entry.name, success );
+
+            if ( !success )
+                statuses[ idx ] = e_apply_status::failed;
+        }
+
+        return statuses;
+    }
+
+    e_apply_status apply_fflag( const entry_t &entry, const c_remote_fflag &fflag )
+    {
+        const c_remote_fflag *pointer = &fflag;
+        write_stats_t         stats { };
+
+        return apply_batch( std::span( &entry, 1 ), std::span( &pointer, 1 ), stats ).front( );
+    }
+
+    outcome_t apply_fflags( const std::vector< entry_t > &entries, const std::vector< c_remote_fflag > &fflags, c_journal &journal )
+    {
+        outcome_t outcome;
+
+        journal.capture( entries, fflags );
+
+        std::vector< const c_remote_fflag * > pointers;
+        pointers.reserve( fflags.size( ) );
+
+        for ( const auto &fflag : fflags )
+            pointers.push_back( &fflag );
+
+        const auto statuses = apply_batch( entries, pointers, outcome.writes );
+
+        for ( std::size_t idx = 0; idx < entries.size( ); ++idx )
+        {
+            if ( statuses[ idx ] == e_apply_status::missing )
+                outcome.missing.push_back( entries[ idx ] );
+
+            if ( statuses[ idx ] != e_apply_status::ok )
+                ++outcome.failed;
+        }
+
+        return outcome;
+    }
+
+    outcome_t apply_tiers( const std::map< std::uint32_t, tier_t > &tiers, const resolver_t &resolve, c_journal &journal )
+    {
+        outcome_t outcome;
+
+        // every lookup waits for the table first, keep that wait out of the per-tier timings
+        if ( g_fflags->singleton( ) )
+            static_cast< void >( g_fflags->table( ) );
+
+        const auto ready = std::chrono::steady_clock::now( );
+
+        for ( const auto &[ tier, group ] : tiers )
+        {
+            const auto fflags  = resolve( group.names );
+            auto       result  = apply_fflags( group.entries, fflags, journal );
+            const auto elapsed = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now( ) - ready ).count( );
+
+            g_logger->summary( "tier {}: {} fflags applied {:.1f} ms after the table became readable ({} failed)", tier,
+                               group.entries.size( ) - result.failed, elapsed, result.failed );
+
+            outcome.missing.insert( outcome.missing.end( ), result.missing.begin( ), result.missing.end( ) );
+            outcome.failed += result.failed;
+            outcome.writes += result.writes;
+        }
+
+        return outcome;
+    }
+
+    void report_writes( const write_stats_t &stats )
+    {
+        g_logger->summary( "{} fflags to write: {} already held their value, {} ranges written in {} syscalls, {} failed verification",
+                           stats.planned, stats.skipped, stats.ranges, stats.syscalls, stats.mismatched );
+    }
+
+    bool settle( const outcome_t &outcome, std::size_t total, bool atomic, c_journal &journal )
+    {
+        if ( !atomic or !outcome.failed )
+        {
+            journal.commit( );
+            return true;
+        }
+
+        g_logger->summary( "============================" );
+
+        if ( journal.rollback( ) )
+            g_logger->summary( "{} of {} fflags could not be applied, rolled every write back in {} writes", outcome.failed, total,
+                               journal.writes( ) );
+        else
+            g_logger->error( "{} of {} fflags could not be applied and rolling back failed, run --restore", outcome.failed, total );
+
+        return false;
+    }
+
+    std::vector< entry_t > watch_pending( std::vector< entry_t > missing, std::chrono::milliseconds timeout, const resolver_t &resolve,
+                                          c_journal &journal )
+    {
+        if ( missing.empty( ) or timeout.count( ) <= 0 or !g_fflags->singleton( ) or !g_memory->target( ).alive( ) )
+            return missing;
+
+        g_logger->summary( "============================" );
+        g_logger->summary( "{} fflags are not registered yet, watching the table for them", missing.size( ) );
+        g_logger->flush( );
+
+        const auto start = std::chrono::steady_clock::now( );
+
+        c_pending pending( std::move( missing ) );
+        pending.watch( timeout, resolve,
+                       [ & ]( const entry_t &entry, const c_remote_fflag &fflag )
+                       {
+                           g_logger->info( "{} was registered late", entry.key );
+
+                           journal.capture( std::span( &entry, 1 ), std::span( &fflag, 1 ) );
+                           static_cast< void >( apply_fflag( entry, fflag ) );
+                       } );
+
+        const auto &stats   = pending.stats( );
+        const auto  elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now( ) - start ).count( );
+
+        g_logger->summary( "watched for {:.1f} s: {} fflags appeared, {} polls, {} changes ({} rehashes)", elapsed, stats.applied,
+                           stats.polls, stats.changes, stats.rehashes );
+        g_logger->summary( "re-walked {} buckets in {:.1f} ms of polling", stats.walks, stats.busy );
+
+        return pending.remaining( );
+    }
+
+    void setup( const apply_config_t &config )
+    {
+        nlohmann::json                    data;
+        std::map< std::uint32_t, tier_t > tiers;
+
+        if ( !load_fflags( data, tiers ) )
+            return;
+
+        std::size_t total { 0 };
+
+        for ( const auto &[ tier, group ] : tiers )
+            total += group.entries.size( );
+
+        lookup_stats_t lookup { };
+
+        const resolver_t resolve = [ & ]( std::span< const std::string > names )
+        {
+            auto fflags = g_fflags->find( names );
+
+            lookup += g_fflags->lookup_stats( );
+            return fflags;
+        };
+
+        c_journal journal( config.journal );
+
+        auto       outcome = apply_tiers( tiers, resolve, journal );
+        const bool kept    = settle( outcome, total, config.atomic, journal );
+
+        // late flags cannot be applied on top of a rolled back run
+        const auto failed = kept ? watch_pending( std::move( outcome.missing ), config.watch, resolve, journal ) : outcome.missing;
+
+        g_logger->summary( "============================" );
+        g_logger->summary( "resolved {} fflags in {} round trips ({} reads, {} syscalls)", lookup.lookups, lookup.ticks, lookup.reads,
+                           lookup.syscalls );
+        report_writes( outcome.writes );
+
+        if ( const auto dropped = g_logger->dropped( ) )
+            g_logger->warning( "{} log records were dropped, the console could not keep up", dropped );
+
+        if ( const auto stats = g_memory->cache_stats( ) )
+        {
+            g_logger->summary( "============================" );
+            g_logger->summary( "page cache: {:.1f}% hit rate, {} reads -> {} syscalls ({} saved)", stats->hit_rate( ) * 100.0,
+                               stats->requests, stats->syscalls, stats->saved( ) );
         }
 
         if ( failed.empty( ) )
         {
-            std::println( "============================" );
-            std::println( "all fflags were set successfully" );
+            if ( kept )
+            {
+                g_logger->summary( "============================" );
+                g_logger->summary( "all fflags were set successfully" );
+            }
+
             return;
         }
 
-        std::println( "============================" );
-        std::println( "failed to set {} fflags", failed.size( ) );
+        g_logger->summary( "============================" );
+        g_logger->summary( "failed to set {} fflags", failed.size( ) );
 
-        for ( const auto &idx : failed )
-            std::println( "failed: {}", idx.c_str( ) );
+        for ( const auto &entry : failed )
+            g_logger->warning( "failed: {}", entry.key );
 
-        std::println( "============================" );
-        std::println( "would you like to remove these missing flags from fflags.json? (y/n)" );
+        g_logger->summary( "============================" );
+        g_logger->summary( "would you like to remove these missing flags from fflags.json? (y/n)" );
+        g_logger->flush( );
 
         std::string user_input;
         std::cin >> user_input;
 
         if ( user_input == "y" or user_input == "Y" )
         {
-            for ( const auto &key_to_remove : failed )
-                data.erase( key_to_remove );
+            for ( const auto &entry : failed )
+                data.erase( entry.key );
 
             std::ofstream out_file( "fflags.json" );
             if ( out_file.is_open( ) )
@@ -210,10 +454,111 @@ namespace odessa::engine
                 out_file << data.dump( 4 );
                 out_file.close( );
 
-                std::println( "removed {} fflags from the list", failed.size( ) );
+                g_logger->summary( "removed {} fflags from the list", failed.size( ) );
             }
             else
-                std::println( "couldn't open fflags.json for writing" );
+                g_logger->error( "couldn't open fflags.json for writing" );
+        }
+    }
+
+    void supervise( const apply_config_t &config )
+    {
+        nlohmann::json                    data;
+        std::map< std::uint32_t, tier_t > tiers;
+
+        if ( !load_fflags( data, tiers ) )
+            return;
+
+        std::size_t total { 0 };
+
+        for ( const auto &[ tier, group ] : tiers )
+            total += group.entries.size( );
+
+        c_supervisor supervisor;
+
+        while ( true )
+        {
+            supervisor.attach( config.scan );
+
+            const resolver_t resolve = [ & ]( std::span< const std::string > names )
+            {
+                return supervisor.resolve( names );
+            };
+
+            c_journal journal( config.journal );
+
+            auto       outcome = apply_tiers( tiers, resolve, journal );
+            const bool kept    = settle( outcome, total, config.atomic, journal );
+
+            supervisor.applied( );
+
+            const auto &stats = supervisor.stats( );
+
+            g_logger->summary( "============================" );
+            g_logger->summary( "session {}: applied {} fflags in {:.1f} ms ({} cached, {} looked up, {} failed)", stats.sessions,
+                               total - outcome.failed, stats.last, stats.reused, stats.looked_up, outcome.failed );
+            g_logger->summary( "restart-to-applied: {:.1f} ms best, {:.1f} ms worst, {:.1f} ms average over {} sessions ({} warm)",
+                               stats.best, stats.worst, stats.average( ), stats.sessions, stats.warm );
+            report_writes( outcome.writes );
+
+            // the instance is kept until it exits anyway, so lazily registered flags can be waited for that long
+            if ( kept )
+            {
+                const auto failed = watch_pending( std::move( outcome.missing ), std::chrono::milliseconds::max( ), resolve, journal );
+
+                for ( const auto &entry : failed )
+                    g_logger->warning( "failed: {}", entry.key );
+            }
+
+            g_logger->summary( "============================" );
+            g_logger->summary( "waiting for the client to restart" );
+
+            supervisor.detach( );
         }
     }
-} // namespace odessa::engine
+
+    bool restore( const std::string &journal_path )
+    {
+        c_journal journal( journal_path );
+
+        if ( !journal.size( ) )
+        {
+            g_logger->summary( "nothing to restore, no fflags were written to this client" );
+            return true;
+        }
+
+        const auto keys   = journal.keys( );
+        const auto ranges = journal.size( );
+
+        if ( !journal.restore( ) )
+        {
+            g_logger->error( "failed to restore every fflag, {} was kept", journal_path );
+            return false;
+        }
+
+        g_logger->summary( "restored {} fflags ({} ranges) to their original values in {} writes", keys, ranges, journal.writes( ) );
+        return true;
+    }
+
+    bool seed( )
+    {
+        const auto mod = g_memory->module( constants::client_name );
+        if ( !mod )
+        {
+            g_logger->error( "failed to find {} in the target", constants::client_name );
+            return false;
+        }
+
+        const auto offset = c_fflags::scan( *g_memory );
+        if ( !offset )
+        {
+            g_logger->error( "failed to find pattern in {}", mod->path );
+            return false;
+        }
+
+        c_fflags::store( *g_memory, offset );
+
+        g_logger->summary( "seeded singleton {:#x} from {}", offset, mod->path );
+        return true;
+    }
+} // namespace odessa::engine
\ No newline at end of file
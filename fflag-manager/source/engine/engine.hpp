@@ -4,14 +4,115 @@
 
 // local->engine
 #include "fflags/fflags.hpp"
+#include "planner/planner.hpp"
+
+// vendor
+#include <nlohmann/json.hpp>
 
 namespace odessa::engine
 {
+    enum class e_apply_status : std::uint8_t
+    {
+        ok           = 0, ///< The value was written
+        missing      = 1, ///< The FFlag does not exist in the client
+        unregistered = 2, ///< The FFlag exists but its GetSet was never registered, writing it would crash the client
+        invalid      = 3, ///< The value could not be converted to the FFlag's type
+        failed       = 4  ///< The write to the client failed
+    };
+
+    struct entry_t
+    {
+        std::string    key;        ///< Key as written in fflags.json
+        std::string    name;       ///< FFlag name with the type prefix stripped
+        e_value_type   value_type; ///< Value type derived from the prefix
+        nlohmann::json value;      ///< Value to apply
+    };
+
+    struct apply_config_t
+    {
+        std::chrono::milliseconds watch { std::chrono::seconds( 30 ) }; ///< How long setup() waits for FFlags registered after startup
+        bool                      atomic { false };                     ///< Roll every write back unless every entry was applied
+        std::string               journal { "journal.json" };           ///< File the undo journal is kept in, empty for memory only
+        scan_config_t             scan { };                             ///< How the client module is scanned for the singleton
+    };
+
+    using resolver_t = std::function< std::vector< c_remote_fflag >( std::span< const std::string > ) >; ///< Looks up FFlags by name
+    using applier_t  = std::function< void( const entry_t &, const c_remote_fflag & ) >;               ///< Applies a resolved FFlag
+
+    /**
+     * @brief Splits an fflags.json key into the FFlag name and the value type its prefix implies.
+     *
+     * @param key The key, e.g. DFIntTaskSchedulerTargetFps.
+     * @param value The value to apply.
+     *
+     * @return The entry. Its name is empty if the key consists of a prefix only.
+     */
+    entry_t make_entry( const std::string &key, nlohmann::json value );
+
+    /**
+     * @brief Converts the values of many entries to the types of their FFlags and writes them as one plan.
+     *
+     * Values that already hold what would be written are skipped, the rest are written in merged spans and read back.
+     *
+     * @param entries The entries to apply.
+     * @param fflags The resolved FFlags in the same order, nullptr where one was not found.
+     * @param stats Accumulates the counters of the plan.
+     *
+     * @return The outcome of every entry, in the same order.
+     */
+    std::vector< e_apply_status > apply_batch( std::span< const entry_t > entries, std::span< const c_remote_fflag *const > fflags,
+                                               write_stats_t &stats );
+
+    /**
+     * @brief Converts an entry's value to the type of its FFlag and writes it.
+     *
+     * @param entry The entry to apply.
+     * @param fflag The resolved FFlag, or an invalid proxy if it was not found.
+     *
+     * @return The outcome of the write.
+     */
+    e_apply_status apply_fflag( const entry_t &entry, const c_remote_fflag &fflag );
+
     /**
      * @brief Sets up the engine and initializes FFlag system.
      *
      * This function reads the fflags.json configuration file and initializes
      * the FFlag management system for the target process.
+     *
+     * The original value of every FFlag is journaled before it is first written, see restore().
+     *
+     * @param config How to apply.
+     */
+    void setup( const apply_config_t &config = { } );
+
+    /**
+     * @brief Keeps the tool resident and re-applies fflags.json every time the client is relaunched.
+     *
+     * Waits for the client to exit, attaches to the next instance and, as long as the build is unchanged,
+     * reuses the singleton offset and FFlag offsets resolved for the previous instance. FFlags the client has not
+     * registered yet are applied as they appear, for as long as the instance runs.
+     *
+     * @param config How to apply. The watch timeout is ignored, every instance is watched until it exits.
+     */
+    void supervise( const apply_config_t &config = { } );
+
+    /**
+     * @brief Reverts every FFlag written to the attached client to its original value, in one coalesced write pass.
+     *
+     * Works from the journal persisted by earlier runs, so it also undoes the writes of a run that crashed.
+     *
+     * @param journal_path The journal file.
+     *
+     * @return True if everything was restored or nothing had to be, false otherwise.
+     */
+    bool restore( const std::string &journal_path );
+
+    /**
+     * @brief Resolves the FFlag singleton against an offline target and pre-seeds address.json.
+     *
+     * Used with a client executable or minidump so the cache is ready before the client is launched.
+     *
+     * @return True if the singleton was resolved and stored, false otherwise.
      */
-    void setup( );
+    bool seed( );
 } // namespace odessa::engine
\ No newline at end of file
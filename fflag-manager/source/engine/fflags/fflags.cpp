@@ -1,79 +1,189 @@
 ﻿#include "fflags.hpp"
 
+// local->misc
+#include "logger/logger.hpp"
+#include "offsets/offsets.hpp"
+
+// local->engine
+#include "heap/heap.hpp"
+
 // vendor
 #include <nlohmann/json.hpp>
 
 namespace odessa::engine
 {
-    c_fflags::c_fflags( ) noexcept
+    c_fflags::c_fflags( const c_memory &memory, std::uint64_t offset ) noexcept
     {
-        std::uint64_t singleton = 0;
+        std::uint64_t stored = 0;
 
         std::ifstream file( "address.json" );
-        if ( file )
+        if ( !offset and file )
         {
             nlohmann::json json;
             file >> json;
 
             if ( json.contains( "singleton" ) )
-                singleton = json[ "singleton" ].get< std::uint64_t >( );
+                stored = json[ "singleton" ].get< std::uint64_t >( );
         }
 
-        // cant be asked to add an actual check to see if roblox is open sry
-        while ( !FindWindowA( nullptr, "Roblox" ) )
-            Sleep( 300 );
+        memory.target( ).wait( );
+
+        c_offset_cache offsets;
+        const auto     build = memory.build( );
 
-        if ( singleton )
+        if ( adopt( memory, offset, "warm" ) or adopt( memory, offsets.find( build ).value_or( 0 ), "shared" ) )
+            return;
+
+        // address.json may have been seeded offline or written before the shared cache existed, pass it on
+        if ( adopt( memory, stored, "cached" ) )
         {
-            auto rebased = g_memory->rebase( singleton, e_rebase_type::add );
-            auto pointer = g_memory->read< std::uint64_t >( rebased );
+            offsets.store( build, stored );
+            return;
+        }
 
-            const auto hash_map = g_memory->read< hash_map_t >( pointer + sizeof( void * ) );
+        // another instance may already be scanning this build, wait for its result instead of scanning the module again
+        const auto claim = c_offset_cache::claim( build );
+        if ( claim and adopt( memory, offsets.find( build ).value_or( 0 ), "shared" ) )
+            return;
 
-            if ( hash_map.mask != 0 and hash_map.list != 0 )
+        const auto rebased = scan( memory );
+        if ( !rebased )
+        {
+            g_logger->warning( "failed to find pattern, scanning the heap for the fflag table" );
+
+            c_heap_scanner scanner( *this, memory );
+            m_singleton = scanner.run( );
+
+            const auto &stats = scanner.stats( );
+            g_logger->info( "scanned {} MiB of private memory in {} ms, {} candidates, {} confirmed", stats.bytes >> 20, stats.milliseconds,
+                            stats.candidates, stats.confirmed );
+
+            if ( !m_singleton )
             {
-                std::println( "found singleton [cached]" );
-                std::println( "============================" );
-                m_singleton = pointer;
+                g_logger->error( "failed to find the fflag table" );
                 return;
             }
+
+            // without a module pointer the singleton cannot be rebased, the next run has to scan again
+            m_offset = c_heap_scanner::anchor( memory, m_singleton );
+            if ( m_offset )
+                store( memory, m_offset );
+
+            g_logger->summary( "found singleton [heap]" );
+            g_logger->summary( "============================" );
+            return;
         }
 
-        const auto result = g_memory->find( constants::pattern );
-        if ( !result )
+        store( memory, rebased );
+
+        g_logger->summary( "found singleton [pattern]" );
+        g_logger->summary( "============================" );
+        m_offset    = rebased;
+        m_singleton = memory.read< std::uint64_t >( memory.rebase( rebased, e_rebase_type::add ) );
+    }
+
+    bool c_fflags::adopt( const c_memory &memory, std::uint64_t offset, std::string_view source ) noexcept
+    {
+        if ( !offset )
+            return false;
+
+        const auto rebased = memory.rebase( offset, e_rebase_type::add );
+        const auto pointer = memory.read< std::uint64_t >( rebased );
+
+        const auto hash_map = memory.read< hash_map_t >( pointer + sizeof( void * ) );
+
+        if ( hash_map.mask == 0 or hash_map.list == 0 )
+            return false;
+
+        g_logger->summary( "found singleton [{}]", source );
+        g_logger->summary( "============================" );
+        m_offset    = offset;
+        m_singleton = pointer;
+        return true;
+    }
+
+    std::optional< std::string > c_remote_fflag::read( ) const noexcept
+    {
+        const auto *local_fflag = this->operator->( );
+        if ( !local_fflag or !registered( ) )
+            return std::nullopt;
+
+        const auto address = reinterpret_cast< std::uint64_t >( local_fflag->value );
+
+        switch ( local_fflag->value_type )
         {
-            std::println( "failed to find pattern" );
-            return;
+            case e_value_type::flag :
+                return g_memory->read< std::uint8_t >( address ) ? "True" : "False";
+            case e_value_type::integer :
+            case e_value_type::log :
+                return std::to_string( g_memory->read< std::int32_t >( address ) );
+            case e_value_type::string :
+            {
+                const auto string = g_memory->read< string_t >( address );
+                if ( string.size > string.allocation or string.size > 0x10000 )
+                    return std::nullopt;
+
+                if ( string.allocation <= inline_capacity )
+                    return std::string( reinterpret_cast< const char * >( string.bytes ), string.size );
+
+                const auto bytes_pointer = *reinterpret_cast< const std::uint64_t * >( string.bytes );
+                const auto bytes         = g_memory->read( bytes_pointer, string.size );
+
+                return std::string( bytes.begin( ), bytes.end( ) );
+            }
+            default :
+                return std::nullopt;
+        }
+    }
+
+    void c_remote_fflag::prefetch( std::span< const c_remote_fflag > fflags ) noexcept
+    {
+        std::vector< read_request_t > requests;
+
+        for ( const auto &fflag : fflags )
+        {
+            if ( !fflag.m_address or fflag.m_cache )
+                continue;
+
+            fflag.m_cache = std::make_unique< fflag_t >( );
+            requests.push_back( { .address = fflag.m_address, .buffer = fflag.m_cache.get( ), .size = sizeof( fflag_t ) } );
         }
 
-        const auto first = ( result + 4 );
+        g_memory->read_batch( requests );
+    }
+
+    std::uint64_t c_fflags::scan( const c_memory &memory ) noexcept
+    {
+        const auto result = memory.find< constants::pattern >( );
 
-        const auto instruction = g_memory->read( first, 7 );
-        const auto relative    = *reinterpret_cast< const std::int32_t * >( instruction.data( ) + 3 );
+        const auto &stats = memory.scan_stats( );
+        g_logger->info( "pattern scan covered {} KiB in {:.1f} ms, the client took {} page faults and its working set changed by {:+} KiB",
+                        stats.bytes >> 10, stats.milliseconds, stats.faults( ), stats.working_set( ) / 1024 );
 
-        const auto target = first + 7 + relative;
+        if ( stats.deferred )
+            g_logger->info( "{} KiB of the module were not resident and {}", stats.deferred >> 10,
+                            stats.fallback ? "had to be read after all" : "were never touched" );
 
-        const auto rebased  = g_memory->rebase( target );
-        const auto absolute = g_memory->read< std::uint64_t >( target );
+        if ( !result )
+            return 0;
 
-        singleton = rebased;
+        return memory.rebase( memory.resolve< constants::pattern >( result ) );
+    }
 
+    void c_fflags::store( const c_memory &memory, std::uint64_t offset ) noexcept
+    {
         nlohmann::json json;
-        json[ "singleton" ] = rebased;
+        json[ "singleton" ] = offset;
 
         std::ofstream out_file( "address.json" );
         out_file << json.dump( 4 );
 
-        std::println( "found singleton [pattern]" );
-        std::println( "============================" );
-        m_singleton = absolute;
+        c_offset_cache offsets;
+        offsets.store( memory.build( ), offset );
     }
 
-    c_remote_fflag c_fflags::find( const std::string &name ) noexcept
+    std::uint64_t c_fflags::hash( std::string_view name ) const noexcept
     {
-        if ( !m_singleton )
-            return c_remote_fflag { 0 };
-
         std::uint64_t basis = m_basis;
         for ( const auto &character : name )
         {
@@ -81,18 +191,41 @@ namespace odessa::engine
             basis *= m_prime;
         }
 
-        std::string entry_name;
-        hash_map_t  hash_map = { };
+        return basis;
+    }
+
+    std::optional< hash_map_t > c_fflags::table( std::chrono::milliseconds timeout ) const noexcept
+    {
+        const auto started = std::chrono::steady_clock::now( );
 
         while ( true )
         {
-            hash_map = g_memory->read< hash_map_t >( m_singleton + sizeof( void * ) );
+            const auto hash_map = g_memory->read< hash_map_t >( m_singleton + sizeof( void * ) );
 
             if ( hash_map.mask != 0 and hash_map.list != 0 )
-                break;
+                return hash_map;
+
+            // the client is still filling the table, make sure the next poll is not served from the cache
+            g_memory->invalidate( );
 
-            Sleep( 100 );
+            if ( !g_memory->target( ).alive( ) or c_target::expired( started, timeout ) )
+                return std::nullopt;
+
+            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
         }
+    }
+
+    c_remote_fflag c_fflags::find( const std::string &name ) noexcept
+    {
+        if ( !m_singleton )
+            return c_remote_fflag { 0 };
+
+        const auto header = table( );
+        if ( !header )
+            return c_remote_fflag { 0 };
+
+        const auto &hash_map = *header;
+        const auto  basis    = hash( name );
 
         const auto bucket_index = basis & hash_map.mask;
         const auto bucket_base  = hash_map.list + bucket_index * sizeof( void * ) * 2;
@@ -102,34 +235,25 @@ namespace odessa::engine
         if ( bucket_nodes.current == hash_map.end )
             return c_remote_fflag { 0 };
 
-        const auto name_length = name.length( );
+        const c_name wanted( name );
 
         while ( true )
         {
-            const auto hash_entry   = g_memory->read< hash_entry_t >( bucket_nodes.current );
-            const auto entry_string = hash_entry.string;
+            const auto  hash_entry   = g_memory->read< hash_entry_t >( bucket_nodes.current );
+            const auto &entry_string = hash_entry.string;
 
-            if ( entry_string.size == name_length )
+            if ( entry_string.allocation > inline_capacity )
             {
-                std::string entry_name;
-
-                if ( entry_string.allocation > 0xf )
+                if ( entry_string.size == name.length( ) )
                 {
                     const auto bytes_pointer = *reinterpret_cast< const std::uint64_t * >( entry_string.bytes );
-                    const auto name_buffer   = g_memory->read( bytes_pointer, entry_string.size );
 
-                    entry_name = std::string( name_buffer.begin( ), name_buffer.end( ) );
+                    if ( wanted.matches( g_memory->read( bytes_pointer, entry_string.size ) ) )
+                        return c_remote_fflag { hash_entry.get_set };
                 }
-                else
-                {
-                    const auto bytes_start = std::begin( entry_string.bytes );
-
-                    entry_name = std::string( bytes_start, ( bytes_start + entry_string.size ) );
-                }
-
-                if ( name == entry_name )
-                    return c_remote_fflag { hash_entry.get_set };
             }
+            else if ( wanted.matches( entry_string.bytes, entry_string.size ) )
+                return c_remote_fflag { hash_entry.get_set };
 
             if ( bucket_nodes.current == bucket_nodes.first )
                 break;
@@ -139,4 +263,26 @@ namespace odessa::engine
 
         return c_remote_fflag { 0 };
     }
-} // namespace odessa::engine
+
+    std::vector< c_remote_fflag > c_fflags::find( std::span< const std::string > names ) noexcept
+    {
+        std::vector< c_remote_fflag > results;
+        results.reserve( names.size( ) );
+
+        if ( !m_singleton )
+        {
+            for ( std::size_t idx = 0; idx < names.size( ); ++idx )
+                results.emplace_back( 0 );
+
+            return results;
+        }
+
+        c_lookup_engine engine( *this );
+
+        for ( const auto address : engine.run( names ) )
+            results.emplace_back( address );
+
+        m_lookup_stats = engine.stats( );
+        return results;
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -6,6 +6,9 @@
 #include "constants.hpp"
 #include "memory/memory.hpp"
 
+// local->engine
+#include "lookup/lookup.hpp"
+
 namespace odessa::engine
 {
     enum class e_value_type : std::uint32_t
@@ -50,7 +53,7 @@ namespace odessa::engine
     struct hash_map_t
     {
         std::uint64_t end;           ///< +0x00 Pointer to the end sentinel node of the hash map
-        std::uint8_t  gap_0[ 0x8 ];  ///< +0x08 Gap / Padding
+        std::uint64_t size;          ///< +0x08 Number of FFlags in the hash map
         std::uint64_t list;          ///< +0x10 Pointer to the bucket list array
         std::uint8_t  gap_1[ 0x10 ]; ///< +0x18 Gap / Padding
         std::uint64_t mask;          ///< +0x28 Hash mask for bucket indexing (bucket_count - 1)
@@ -100,50 +103,35 @@ namespace odessa::engine
         }
 
         /**
-         * @brief Sets the value of the remote FFlag.
+         * @brief Checks whether the client registered a GetSet for the FFlag.
          *
-         * @tparam type_t The type of data to write.
-         * @param new_value The new value to write to the flag's value pointer.
+         * Unregistered GetSets hold a placeholder instead of a value pointer, writing through it would crash the client.
          *
-         * @return True if the write operation was successful, false otherwise.
+         * @return True if the value pointer can be written through, false otherwise.
          */
-        template < typename type_t >
-        bool set( const type_t &new_value ) const noexcept
+        [[nodiscard]] bool registered( ) const noexcept
         {
             const auto *local_fflag = this->operator->( );
             if ( !local_fflag )
                 return false;
 
-            return g_memory->write( reinterpret_cast< std::uint64_t >( local_fflag->value ), new_value );
+            const auto value = reinterpret_cast< std::uint64_t >( local_fflag->value );
+            return value != 0x65757254 and value != 0x31303031;
         }
 
         /**
-         * @brief Sets the value for std::string types.
-         *
-         * @param new_value The new string value to set.
+         * @brief Reads the current value of the FFlag and formats it the way fflags.json writes it.
          *
-         * @return True if the operation was successful, false otherwise.
+         * @return The value, or std::nullopt if it could not be read.
          */
-        bool set( const std::string &new_value ) const noexcept
-        {
-            const auto *local_fflag = this->operator->( );
-            if ( !local_fflag )
-                return false;
-
-            const auto address  = reinterpret_cast< std::uint64_t >( local_fflag->value );
-            const auto capacity = g_memory->read< std::uint64_t >( address + ( sizeof( void * ) * 2 ) );
-
-            if ( new_value.length( ) > capacity )
-                return false;
+        [[nodiscard]] std::optional< std::string > read( ) const noexcept;
 
-            const auto buffer = g_memory->read< std::uint64_t >( address );
-
-            const bool written = g_memory->write( buffer, new_value.c_str( ), new_value.length( ) + 1 ); // +1 for null terminator
-            if ( !written )
-                return false;
-
-            return g_memory->write( address + sizeof( void * ), new_value.length( ) );
-        }
+        /**
+         * @brief Reads the fflag_t of every proxy that has not cached it yet, in one batch.
+         *
+         * @param fflags The proxies to fill.
+         */
+        static void prefetch( std::span< const c_remote_fflag > fflags ) noexcept;
 
         /**
          * @brief Returns the remote address of the fflag.
@@ -172,12 +160,41 @@ namespace odessa::engine
         std::uint64_t m_prime { 0x100000001b3 };     ///< FNV-1a 64-bit prime
 
         std::uint64_t m_singleton { 0 }; ///< Address of the FFlag singleton
+        std::uint64_t m_offset { 0 };    ///< Offset of the singleton pointer from the module base
+
+        lookup_stats_t m_lookup_stats { }; ///< Counters of the last batched lookup
+
+        /**
+         * @brief Takes a singleton offset resolved earlier if it still points at a populated table.
+         *
+         * @param memory The memory of the client.
+         * @param offset The singleton's offset from the module base, 0 to skip.
+         * @param source Where the offset came from, for the log.
+         *
+         * @return True if the offset was taken, false otherwise.
+         */
+        bool adopt( const c_memory &memory, std::uint64_t offset, std::string_view source ) noexcept;
 
       public:
         /**
          * @brief Constructs the FFlag manager and locates the FFlag singleton.
+         *
+         * Tries the given offset, then the shared offset cache, then address.json. Only if all of them are stale does it
+         * scan, and only one instance scans a build at a time, the others pick up its result from the shared cache.
+         * Only reads through the given memory, so it does not need to be installed as g_memory yet.
+         *
+         * @param memory The memory of the client.
+         * @param offset A singleton offset already known to match the running build. Skips address.json when set,
+         *               and falls back to the scan if it turns out to be stale.
          */
-        c_fflags( ) noexcept;
+        c_fflags( const c_memory &memory, std::uint64_t offset = 0 ) noexcept;
+
+        /**
+         * @brief Constructs the FFlag manager for g_memory, see above.
+         *
+         * @param offset A singleton offset already known to match the running build.
+         */
+        c_fflags( std::uint64_t offset = 0 ) noexcept : c_fflags( *g_memory, offset ) { }
 
         /**
          * @brief Finds an FFlag by name using FNV-1a hashing.
@@ -192,6 +209,57 @@ namespace odessa::engine
          */
         c_remote_fflag find( const std::string &name ) noexcept;
 
+        /**
+         * @brief Finds many FFlags at once.
+         *
+         * Every lookup runs as a coroutine on a c_lookup_engine, so the bucket walks of all names advance
+         * together and their remote reads are issued as coalesced batches.
+         *
+         * @param names The names of the FFlags to find (case-sensitive).
+         *
+         * @return One proxy per name, in the same order. Missing flags yield an invalid proxy.
+         */
+        std::vector< c_remote_fflag > find( std::span< const std::string > names ) noexcept;
+
+        /**
+         * @brief Computes the FNV-1a hash the client uses to bucket an FFlag name.
+         *
+         * @param name The name of the FFlag.
+         *
+         * @return The 64-bit hash.
+         */
+        [[nodiscard]] std::uint64_t hash( std::string_view name ) const noexcept;
+
+        /**
+         * @brief Reads the FFlag hash table header, waiting until the client has populated it.
+         *
+         * Gives up early once the client has exited. Offline targets never change, they are read once.
+         *
+         * @param timeout How long to wait for the client.
+         *
+         * @return The hash table header, or std::nullopt if it was still empty.
+         */
+        [[nodiscard]] std::optional< hash_map_t > table( std::chrono::milliseconds timeout = c_target::forever ) const noexcept;
+
+        /**
+         * @brief Locates the FFlag singleton in the client module with constants::pattern.
+         *
+         * Works against any target, including offline images and minidumps.
+         *
+         * @param memory The memory of the client.
+         *
+         * @return The singleton's offset from the module base, or 0 if the pattern was not found.
+         */
+        static std::uint64_t scan( const c_memory &memory ) noexcept;
+
+        /**
+         * @brief Stores the singleton's offset in address.json and the shared offset cache so later runs can skip the scan.
+         *
+         * @param memory The memory of the client.
+         * @param offset The singleton's offset from the module base.
+         */
+        static void store( const c_memory &memory, std::uint64_t offset ) noexcept;
+
         /**
          * @brief Returns the value of the m_singleton member variable.
          *
@@ -201,6 +269,26 @@ namespace odessa::engine
         {
             return m_singleton;
         }
+
+        /**
+         * @brief Returns the offset of the singleton pointer from the module base.
+         *
+         * @return The offset, or 0 if the singleton was not found.
+         */
+        [[nodiscard]] std::uint64_t offset( ) const noexcept
+        {
+            return m_offset;
+        }
+
+        /**
+         * @brief Returns the counters of the last batched lookup.
+         *
+         * @return The lookup counters.
+         */
+        [[nodiscard]] const lookup_stats_t &lookup_stats( ) const noexcept
+        {
+            return m_lookup_stats;
+        }
     };
 
     inline auto g_fflags { std::unique_ptr< c_fflags > {} };
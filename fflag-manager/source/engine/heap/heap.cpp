@@ -0,0 +1,229 @@
+#include "heap.hpp"
+
+// local->misc
+#include "constants.hpp"
+#include "memory/memory.hpp"
+
+// local->engine
+#include "fflags/fflags.hpp"
+#include "names/names.hpp"
+
+namespace odessa::engine
+{
+    void c_heap_scanner::filter( std::uint64_t base, std::span< const std::uint8_t > bytes,
+                                 std::vector< std::uint64_t > &candidates ) noexcept
+    {
+        constexpr auto table_words = sizeof( hash_map_t ) / sizeof( std::uint64_t );
+        constexpr auto mask_word   = offsetof( hash_map_t, mask ) / sizeof( std::uint64_t );
+
+        const auto count = bytes.size( ) / sizeof( std::uint64_t );
+        if ( count < table_words )
+            return;
+
+        const auto user_pointer = []( std::uint64_t pointer )
+        {
+            return pointer != 0 and pointer % sizeof( std::uint64_t ) == 0 and pointer < 0x800000000000;
+        };
+
+        const auto check = [ & ]( std::size_t idx )
+        {
+            hash_map_t table;
+            std::memcpy( &table, bytes.data( ) + idx * sizeof( std::uint64_t ), sizeof( hash_map_t ) );
+
+            if ( user_pointer( table.end ) and user_pointer( table.list ) and table.end != table.list )
+                candidates.push_back( base + idx * sizeof( std::uint64_t ) );
+        };
+
+        const auto last = count - table_words;
+
+        std::size_t idx { 0 };
+
+#ifdef ODESSA_SSE2
+        const auto one  = _mm_set1_epi64x( 1 );
+        const auto low  = _mm_set1_epi64x( 1ll << mask_low_bit );
+        const auto zero = _mm_setzero_si128( );
+
+        for ( ; idx + 1 <= last; idx += 2 )
+        {
+            const auto *words = bytes.data( ) + ( idx + mask_word ) * sizeof( std::uint64_t );
+            const auto  mask  = _mm_loadu_si128( reinterpret_cast< const __m128i * >( words ) );
+
+            // a lane ends up zero only if its mask is 2^n - 1 with mask_low_bit < n <= mask_bits
+            const auto power    = _mm_and_si128( mask, _mm_add_epi64( mask, one ) );
+            const auto rejected = _mm_or_si128( _mm_or_si128( power, _mm_srli_epi64( mask, mask_bits ) ), _mm_andnot_si128( mask, low ) );
+            const auto lanes    = _mm_movemask_epi8( _mm_cmpeq_epi8( rejected, zero ) );
+
+            if ( ( lanes & 0xff ) == 0xff )
+                check( idx );
+
+            if ( ( lanes >> 8 ) == 0xff )
+                check( idx + 1 );
+        }
+#endif
+
+        for ( ; idx <= last; ++idx )
+        {
+            std::uint64_t mask;
+            std::memcpy( &mask, bytes.data( ) + ( idx + mask_word ) * sizeof( std::uint64_t ), sizeof( mask ) );
+
+            if ( ( mask & ( mask + 1 ) ) == 0 and ( mask >> mask_bits ) == 0 and ( mask >> mask_low_bit & 1 ) )
+                check( idx );
+        }
+    }
+
+    bool c_heap_scanner::plausible( std::string_view name ) noexcept
+    {
+        if ( name.empty( ) or !std::isalpha( static_cast< unsigned char >( name.front( ) ) ) )
+            return false;
+
+        return std::ranges::all_of( name,
+                                    []( unsigned char c )
+                                    {
+                                        return std::isalnum( c ) or c == '_';
+                                    } );
+    }
+
+    std::size_t c_heap_scanner::confirm( const hash_map_t &table ) const noexcept
+    {
+        const auto buckets = std::min( table.mask + 1, sample_buckets );
+        const auto list    = m_memory.read( table.list, buckets * sizeof( nodes_t ) );
+
+        if ( list.size( ) != buckets * sizeof( nodes_t ) )
+            return 0;
+
+        std::size_t proven { 0 };
+
+        for ( std::uint64_t bucket = 0; bucket < buckets; ++bucket )
+        {
+            nodes_t bucket_nodes;
+            std::memcpy( &bucket_nodes, list.data( ) + bucket * sizeof( nodes_t ), sizeof( nodes_t ) );
+
+            if ( bucket_nodes.current == table.end or !bucket_nodes.current )
+                continue;
+
+            for ( std::uint64_t node = 0; node < sample_nodes; ++node )
+            {
+                const auto  hash_entry   = m_memory.read< hash_entry_t >( bucket_nodes.current );
+                const auto &entry_string = hash_entry.string;
+
+                if ( entry_string.size > name_limit )
+                    return 0;
+
+                std::string name;
+
+                if ( entry_string.allocation > inline_capacity )
+                {
+                    const auto bytes_pointer = *reinterpret_cast< const std::uint64_t * >( entry_string.bytes );
+                    const auto name_buffer   = m_memory.read( bytes_pointer, entry_string.size );
+
+                    name.assign( name_buffer.begin( ), name_buffer.end( ) );
+                }
+                else if ( entry_string.size <= inline_capacity )
+                    name.assign( reinterpret_cast< const char * >( entry_string.bytes ), entry_string.size );
+
+                // a name in the wrong bucket means the map is keyed or hashed differently
+                if ( name.size( ) != entry_string.size or !plausible( name ) or ( m_fflags.hash( name ) & table.mask ) != bucket )
+                    return 0;
+
+                const auto fflag = m_memory.read< fflag_t >( hash_entry.get_set );
+
+                if ( !fflag.vftable or !fflag.value or fflag.value_type < e_value_type::log or fflag.value_type > e_value_type::flag )
+                    return 0;
+
+                ++proven;
+
+                if ( bucket_nodes.current == bucket_nodes.first or !hash_entry.forward )
+                    break;
+
+                bucket_nodes.current = hash_entry.forward;
+            }
+        }
+
+        return proven;
+    }
+
+    std::uint64_t c_heap_scanner::run( ) noexcept
+    {
+        const auto start = std::chrono::steady_clock::now( );
+
+        m_stats = { };
+
+        std::mutex                   mutex;
+        std::vector< std::uint64_t > candidates;
+
+        m_stats.bytes = m_memory.heap( sizeof( hash_map_t ) - sizeof( std::uint64_t ),
+                                       [ & ]( std::uint64_t base, std::span< const std::uint8_t > bytes )
+                                       {
+                                           std::vector< std::uint64_t > found;
+                                           filter( base, bytes, found );
+
+                                           if ( found.empty( ) )
+                                               return;
+
+                                           std::scoped_lock lock( mutex );
+                                           candidates.insert( candidates.end( ), found.begin( ), found.end( ) );
+                                       } );
+
+        // overlapping chunks report a candidate twice
+        std::ranges::sort( candidates );
+        const auto [ first, last ] = std::ranges::unique( candidates );
+        candidates.erase( first, last );
+
+        m_stats.candidates = candidates.size( );
+
+        std::uint64_t result { 0 };
+        std::uint64_t best_mask { 0 };
+
+        for ( const auto address : candidates )
+        {
+            const auto table = m_memory.read< hash_map_t >( address );
+
+            if ( confirm( table ) < sample_minimum )
+                continue;
+
+            ++m_stats.confirmed;
+
+            // other string keyed maps can pass as well, the FFlag table is by far the largest of them
+            if ( table.mask > best_mask )
+            {
+                best_mask = table.mask;
+                result    = address - sizeof( void * );
+            }
+        }
+
+        const auto elapsed   = std::chrono::steady_clock::now( ) - start;
+        m_stats.milliseconds = std::chrono::duration_cast< std::chrono::milliseconds >( elapsed ).count( );
+
+        return result;
+    }
+
+    std::uint64_t c_heap_scanner::anchor( const c_memory &memory, std::uint64_t singleton ) noexcept
+    {
+        const auto mod = memory.module( constants::client_name );
+        if ( !mod )
+            return 0;
+
+        std::uint64_t result { 0 };
+
+        memory.regions(
+            [ & ]( std::uint64_t base, std::span< const std::uint8_t > buffer )
+            {
+                for ( std::size_t offset = ( sizeof( void * ) - base % sizeof( void * ) ) % sizeof( void * );
+                      offset + sizeof( std::uint64_t ) <= buffer.size( ); offset += sizeof( void * ) )
+                {
+                    std::uint64_t value;
+                    std::memcpy( &value, buffer.data( ) + offset, sizeof( value ) );
+
+                    if ( value == singleton )
+                    {
+                        result = base + offset - mod->base;
+                        return false;
+                    }
+                }
+
+                return true;
+            } );
+
+        return result;
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "memory/memory.hpp"
+
+namespace odessa::engine
+{
+    class c_fflags;
+    struct hash_map_t;
+
+    struct heap_stats_t
+    {
+        std::uint64_t bytes { 0 };        ///< Bytes of private memory scanned
+        std::uint64_t candidates { 0 };   ///< Offsets shaped like a hash_map_t that passed the vectorized filter
+        std::uint64_t confirmed { 0 };    ///< Candidates whose sampled entries all looked like FFlags
+        std::uint64_t milliseconds { 0 }; ///< Time the scan took
+    };
+
+    class c_heap_scanner
+    {
+        static constexpr std::uint64_t mask_low_bit { 7 };    ///< Bit every plausible mask has set, i.e. at least 256 buckets
+        static constexpr std::uint64_t mask_bits { 24 };      ///< Bits a plausible mask may span, i.e. at most 16M buckets
+        static constexpr std::uint64_t sample_buckets { 64 }; ///< Leading buckets of a candidate inspected when confirming it
+        static constexpr std::uint64_t sample_nodes { 4 };    ///< Nodes followed per sampled bucket
+        static constexpr std::uint64_t sample_minimum { 8 };  ///< Entries a candidate must prove to be confirmed
+        static constexpr std::uint64_t name_limit { 0x100 };  ///< Longest name a sampled entry may have
+
+        const c_fflags &m_fflags;    ///< FFlag manager providing the hash
+        const c_memory &m_memory;    ///< Memory of the client that is scanned
+        heap_stats_t    m_stats { }; ///< Counters of the last run
+
+        /**
+         * @brief Collects every 8 byte aligned offset of a chunk whose bytes are shaped like a hash_map_t.
+         *
+         * The mask word is tested two lanes at a time with SSE2 for being one less than a power of two within the
+         * plausible range, then the surviving offsets are checked for user mode `end` and `list` pointers.
+         *
+         * @param base The address of the chunk.
+         * @param bytes The contents of the chunk.
+         * @param candidates Receives the address of each match.
+         */
+        static void filter( std::uint64_t base, std::span< const std::uint8_t > bytes, std::vector< std::uint64_t > &candidates ) noexcept;
+
+        /**
+         * @brief Checks whether a name read from a candidate could be an FFlag name with its prefix stripped.
+         */
+        [[nodiscard]] static bool plausible( std::string_view name ) noexcept;
+
+        /**
+         * @brief Walks the leading buckets of a candidate and checks each entry against the FFlag table layout.
+         *
+         * Every sampled entry must have a plausible name that hashes to the bucket it was found in, and a GetSet
+         * that looks like an fflag_t.
+         *
+         * @param table The candidate hash table header.
+         *
+         * @return The number of entries sampled, or 0 if any entry did not fit.
+         */
+        [[nodiscard]] std::size_t confirm( const hash_map_t &table ) const noexcept;
+
+      public:
+        /**
+         * @brief Creates a heap scanner for an FFlag manager.
+         *
+         * @param fflags The FFlag manager providing the hash.
+         * @param memory The memory of the client to scan.
+         */
+        c_heap_scanner( const c_fflags &fflags, const c_memory &memory ) noexcept : m_fflags( fflags ), m_memory( memory ) { }
+
+        /**
+         * @brief Locates the FFlag table without a signature by scanning private memory for its hash_map_t.
+         *
+         * Used when constants::pattern no longer matches after a client update.
+         *
+         * @return The address of the FFlag singleton, or 0 if no candidate was confirmed.
+         */
+        std::uint64_t run( ) noexcept;
+
+        /**
+         * @brief Finds the pointer to the singleton in the client module, i.e. what constants::pattern resolves to.
+         *
+         * @param memory The memory of the client.
+         * @param singleton The address of the FFlag singleton.
+         *
+         * @return The pointer's offset from the module base, or 0 if the module holds no pointer to the singleton.
+         */
+        static std::uint64_t anchor( const c_memory &memory, std::uint64_t singleton ) noexcept;
+
+        /**
+         * @brief Returns the counters of the last run.
+         *
+         * @return The scan counters.
+         */
+        [[nodiscard]] const heap_stats_t &stats( ) const noexcept
+        {
+            return m_stats;
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
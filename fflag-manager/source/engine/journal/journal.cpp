@@ -0,0 +1,268 @@
+#include "journal.hpp"
+
+// local->misc
+#include "logger/logger.hpp"
+
+// standard
+#include <charconv>
+
+namespace odessa::engine
+{
+    namespace
+    {
+        std::string to_hex( std::span< const std::uint8_t > bytes )
+        {
+            constexpr std::string_view digits = "0123456789abcdef";
+
+            std::string hex;
+            hex.reserve( bytes.size( ) * 2 );
+
+            for ( const auto byte : bytes )
+            {
+                hex.push_back( digits[ byte >> 4 ] );
+                hex.push_back( digits[ byte & 0xf ] );
+            }
+
+            return hex;
+        }
+
+        std::vector< std::uint8_t > from_hex( std::string_view hex )
+        {
+            std::vector< std::uint8_t > bytes( hex.size( ) / 2 );
+
+            for ( std::size_t idx = 0; idx < bytes.size( ); ++idx )
+                std::from_chars( hex.data( ) + idx * 2, hex.data( ) + idx * 2 + 2, bytes[ idx ], 16 );
+
+            return bytes;
+        }
+    } // namespace
+
+    c_journal::c_journal( std::string path ) noexcept :
+        m_path( std::move( path ) ), m_pid( g_memory->pid( ) ), m_build( g_memory->build( ) )
+    {
+        if ( m_path.empty( ) )
+            return;
+
+        std::ifstream file( m_path );
+        if ( !file )
+            return;
+
+        try
+        {
+            nlohmann::json json;
+            file >> json;
+
+            const build_t build { .timestamp = json[ "build" ][ "timestamp" ].get< std::uint32_t >( ),
+                                  .size      = json[ "build" ][ "size" ].get< std::uint32_t >( ) };
+
+            // the client was restarted since, it is back at its defaults and the addresses no longer apply
+            if ( json[ "pid" ].get< std::int32_t >( ) != m_pid or build != m_build )
+            {
+                g_logger->debug( "discarding the journal of pid {}", json[ "pid" ].get< std::int32_t >( ) );
+                return;
+            }
+
+            for ( const auto &entry : json[ "entries" ] )
+            {
+                add( { .key     = entry[ "key" ].get< std::string >( ),
+                       .address = entry[ "address" ].get< std::uint64_t >( ),
+                       .bytes   = from_hex( entry[ "bytes" ].get< std::string >( ) ) } );
+            }
+
+            // ranges from an earlier run are not part of this run's transaction
+            commit( );
+
+            g_logger->info( "picked up a journal of {} fflags from an earlier run", keys( ) );
+        }
+        catch ( const nlohmann::json::exception &eggsception )
+        {
+            g_logger->warning( "failed to parse {}: {}", m_path, eggsception.what( ) );
+        }
+    }
+
+    void c_journal::add( journal_entry_t entry ) noexcept
+    {
+        if ( m_touched.insert( entry.address ).second )
+            m_transaction.push_back( entry );
+
+        if ( m_journaled.insert( entry.address ).second )
+            m_entries.push_back( std::move( entry ) );
+    }
+
+    void c_journal::save( ) const noexcept
+    {
+        if ( m_path.empty( ) )
+            return;
+
+        nlohmann::json json;
+        json[ "pid" ]   = m_pid;
+        json[ "build" ] = { { "timestamp", m_build.timestamp }, { "size", m_build.size } };
+
+        auto &entries = json[ "entries" ] = nlohmann::json::array( );
+
+        for ( const auto &entry : m_entries )
+            entries.push_back( { { "key", entry.key }, { "address", entry.address }, { "bytes", to_hex( entry.bytes ) } } );
+
+        const auto temporary = m_path + ".tmp";
+
+        {
+            std::ofstream out_file( temporary, std::ios::trunc );
+            out_file << json.dump( 4 );
+
+            if ( !out_file.flush( ) )
+            {
+                g_logger->error( "couldn't write {}", temporary );
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename( temporary, m_path, error );
+
+        if ( error )
+            g_logger->error( "couldn't replace {}: {}", m_path, error.message( ) );
+    }
+
+    void c_journal::capture( std::span< const entry_t > entries, std::span< const c_remote_fflag > fflags ) noexcept
+    {
+        c_remote_fflag::prefetch( fflags );
+
+        std::vector< std::size_t >                                    owners;
+        std::vector< std::array< std::uint8_t, sizeof( string_t ) > > values;
+        std::vector< read_request_t >                                 requests;
+
+        for ( std::size_t idx = 0; idx < fflags.size( ); ++idx )
+        {
+            const auto &fflag = fflags[ idx ];
+
+            // unregistered GetSets are never written, and a range already in the transaction holds what it held before it
+            if ( !fflag or !fflag.registered( ) or m_touched.contains( reinterpret_cast< std::uint64_t >( fflag->value ) ) )
+                continue;
+
+            owners.push_back( idx );
+            requests.push_back( { .address = reinterpret_cast< std::uint64_t >( fflag->value ),
+                                  .size    = fflag->value_type == e_value_type::string ? sizeof( string_t ) : sizeof( std::int32_t ) } );
+        }
+
+        values.resize( requests.size( ) );
+
+        for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+            requests[ idx ].buffer = values[ idx ].data( );
+
+        g_memory->read_batch( requests );
+
+        std::vector< std::size_t >                 string_owners;
+        std::vector< std::vector< std::uint8_t > > buffers;
+        std::vector< read_request_t >              string_requests;
+
+        for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+        {
+            const auto &request = requests[ idx ];
+
+            if ( request.result != request.size )
+            {
+                g_logger->warning( "failed to capture the value of {}, it cannot be restored", entries[ owners[ idx ] ].key );
+                continue;
+            }
+
+            add( { .key     = entries[ owners[ idx ] ].key,
+                   .address = request.address,
+                   .bytes   = { values[ idx ].begin( ), values[ idx ].begin( ) + request.size } } );
+
+            if ( request.size != sizeof( string_t ) )
+                continue;
+
+            string_t string;
+            std::memcpy( &string, values[ idx ].data( ), sizeof( string_t ) );
+
+            // inline strings live entirely in the string_t, heap buffers are overwritten in place and need their own range
+            if ( string.allocation <= inline_capacity or string.allocation > string_limit )
+                continue;
+
+            string_owners.push_back( owners[ idx ] );
+            buffers.emplace_back( string.allocation + 1 );
+            string_requests.push_back( { .address = *reinterpret_cast< const std::uint64_t * >( string.bytes ),
+                                         .size    = string.allocation + 1 } );
+        }
+
+        for ( std::size_t idx = 0; idx < string_requests.size( ); ++idx )
+            string_requests[ idx ].buffer = buffers[ idx ].data( );
+
+        g_memory->read_batch( string_requests );
+
+        for ( std::size_t idx = 0; idx < string_requests.size( ); ++idx )
+        {
+            if ( string_requests[ idx ].result != string_requests[ idx ].size )
+            {
+                g_logger->warning( "failed to capture the value of {}, it cannot be restored", entries[ string_owners[ idx ] ].key );
+                continue;
+            }
+
+            add( { .key     = entries[ string_owners[ idx ] ].key,
+                   .address = string_requests[ idx ].address,
+                   .bytes   = std::move( buffers[ idx ] ) } );
+        }
+
+        save( );
+    }
+
+    bool c_journal::write( std::span< const journal_entry_t > entries ) noexcept
+    {
+        std::vector< write_request_t > requests;
+        requests.reserve( entries.size( ) );
+
+        for ( const auto &entry : entries )
+            requests.push_back( { .address = entry.address, .buffer = entry.bytes.data( ), .size = entry.bytes.size( ) } );
+
+        m_writes = g_memory->write_batch( requests );
+
+        bool written = true;
+
+        for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+        {
+            if ( requests[ idx ].written )
+                continue;
+
+            g_logger->warning( "failed to write back {} at {:#x}", entries[ idx ].key, entries[ idx ].address );
+            written = false;
+        }
+
+        return written;
+    }
+
+    bool c_journal::rollback( ) noexcept
+    {
+        const bool written = write( m_transaction );
+
+        commit( );
+        return written;
+    }
+
+    bool c_journal::restore( ) noexcept
+    {
+        if ( !write( m_entries ) )
+            return false;
+
+        m_entries.clear( );
+        m_journaled.clear( );
+        commit( );
+
+        if ( !m_path.empty( ) )
+        {
+            std::error_code error;
+            std::filesystem::remove( m_path, error );
+        }
+
+        return true;
+    }
+
+    std::size_t c_journal::keys( ) const noexcept
+    {
+        std::set< std::string_view > keys;
+
+        for ( const auto &entry : m_entries )
+            keys.insert( entry.key );
+
+        return keys.size( );
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->engine
+#include "engine.hpp"
+
+namespace odessa::engine
+{
+    struct journal_entry_t
+    {
+        std::string                 key { };       ///< Key of the entry the range was captured for
+        std::uint64_t               address { 0 }; ///< Address of the range
+        std::vector< std::uint8_t > bytes { };     ///< Bytes the range held before it was written
+    };
+
+    class c_journal
+    {
+        static constexpr std::uint64_t string_limit { 0x10000 }; ///< Largest heap string buffer captured
+
+        std::string  m_path { };     ///< File the journal is persisted to, empty to keep it in memory
+        std::int32_t m_pid { 0 };    ///< Client instance the addresses belong to
+        build_t      m_build { };    ///< Client build the addresses belong to
+        std::size_t  m_writes { 0 }; ///< Writes issued by the last rollback() or restore()
+
+        std::vector< journal_entry_t > m_entries { };     ///< Original bytes of every range written to the client instance
+        std::vector< journal_entry_t > m_transaction { }; ///< Bytes every range written since the last commit() held before
+        std::set< std::uint64_t >      m_journaled { };   ///< Addresses in m_entries
+        std::set< std::uint64_t >      m_touched { };     ///< Addresses in m_transaction
+
+        /**
+         * @brief Adds a captured range to the transaction and, the first time its address is seen, to the journal.
+         *
+         * @param entry The captured range.
+         */
+        void add( journal_entry_t entry ) noexcept;
+
+        /**
+         * @brief Writes the journal to m_path, through a temporary file so a crash never leaves it half written.
+         */
+        void save( ) const noexcept;
+
+        /**
+         * @brief Writes captured ranges back in one coalesced pass.
+         *
+         * @param entries The ranges to write.
+         *
+         * @return True if every range was written, false otherwise.
+         */
+        bool write( std::span< const journal_entry_t > entries ) noexcept;
+
+      public:
+        /**
+         * @brief Opens the journal of the attached client instance.
+         *
+         * A journal left behind by an earlier run is only picked up if it belongs to the same process and build,
+         * otherwise its addresses are meaningless and it is discarded.
+         *
+         * @param path The file the journal is persisted to, empty to keep it in memory.
+         */
+        c_journal( std::string path ) noexcept;
+
+        /**
+         * @brief Captures the current values of FFlags before they are written.
+         *
+         * Reads the GetSets, then every value, then the heap buffers of string values, each as one batch. Integer
+         * values take 4 bytes and string values their whole string_t, plus the buffer for heap allocated strings.
+         * Ranges already journaled keep their original bytes. The journal is saved before this returns.
+         *
+         * @param entries The entries about to be applied.
+         * @param fflags The resolved FFlags, in the same order.
+         */
+        void capture( std::span< const entry_t > entries, std::span< const c_remote_fflag > fflags ) noexcept;
+
+        /**
+         * @brief Ends the current transaction, its writes can no longer be rolled back on their own.
+         */
+        void commit( ) noexcept
+        {
+            m_transaction.clear( );
+            m_touched.clear( );
+        }
+
+        /**
+         * @brief Reverts every write of the current transaction to what it held before, then ends the transaction.
+         *
+         * @return True if every range was written back, false otherwise.
+         */
+        bool rollback( ) noexcept;
+
+        /**
+         * @brief Reverts every journaled range to its original value and discards the journal.
+         *
+         * @return True if every range was written back, false otherwise. The journal is kept on failure.
+         */
+        bool restore( ) noexcept;
+
+        /**
+         * @brief Returns the number of distinct keys in the journal.
+         *
+         * @return The number of keys.
+         */
+        [[nodiscard]] std::size_t keys( ) const noexcept;
+
+        /**
+         * @brief Returns the number of journaled ranges.
+         *
+         * @return The number of ranges.
+         */
+        [[nodiscard]] std::size_t size( ) const noexcept
+        {
+            return m_entries.size( );
+        }
+
+        /**
+         * @brief Returns the writes issued by the last rollback() or restore(), after coalescing.
+         *
+         * @return The number of writes.
+         */
+        [[nodiscard]] std::size_t writes( ) const noexcept
+        {
+            return m_writes;
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "lookup.hpp"
+
+// local->misc
+#include "memory/memory.hpp"
+
+// local->engine
+#include "fflags/fflags.hpp"
+
+namespace odessa::engine
+{
+    lookup_task_t c_lookup_engine::walk( const c_name &name, const hash_map_t &table, std::uint64_t &result ) noexcept
+    {
+        result = 0;
+
+        const auto bucket_index = m_fflags.hash( name.view( ) ) & table.mask;
+        const auto bucket_base  = table.list + bucket_index * sizeof( void * ) * 2;
+
+        auto bucket_nodes = co_await read< nodes_t >( bucket_base );
+
+        if ( bucket_nodes.current == table.end or !bucket_nodes.current )
+            co_return;
+
+        while ( true )
+        {
+            const auto  hash_entry   = co_await read< hash_entry_t >( bucket_nodes.current );
+            const auto &entry_string = hash_entry.string;
+
+            if ( entry_string.allocation > inline_capacity )
+            {
+                if ( entry_string.size == name.view( ).size( ) )
+                {
+                    const auto bytes_pointer = *reinterpret_cast< const std::uint64_t * >( entry_string.bytes );
+                    const auto name_buffer   = co_await read( bytes_pointer, entry_string.size );
+
+                    if ( name.matches( name_buffer ) )
+                    {
+                        result = hash_entry.get_set;
+                        co_return;
+                    }
+                }
+            }
+            else if ( name.matches( entry_string.bytes, entry_string.size ) )
+            {
+                result = hash_entry.get_set;
+                co_return;
+            }
+
+            if ( bucket_nodes.current == bucket_nodes.first or !hash_entry.forward )
+                break;
+
+            bucket_nodes.current = hash_entry.forward;
+        }
+    }
+
+    lookup_task_t c_lookup_engine::sweep( std::uint64_t bucket, const hash_map_t &table, const c_name_set &wanted,
+                                          std::vector< std::uint64_t > &results ) noexcept
+    {
+        auto bucket_nodes = co_await read< nodes_t >( table.list + bucket * sizeof( void * ) * 2 );
+
+        if ( bucket_nodes.current == table.end or !bucket_nodes.current )
+            co_return;
+
+        while ( true )
+        {
+            const auto  hash_entry   = co_await read< hash_entry_t >( bucket_nodes.current );
+            const auto &entry_string = hash_entry.string;
+
+            auto idx = std::string_view::npos;
+
+            if ( entry_string.allocation > inline_capacity )
+            {
+                // only fetch heap names whose length some wanted name has
+                if ( wanted.wants( entry_string.size ) )
+                {
+                    const auto bytes_pointer = *reinterpret_cast< const std::uint64_t * >( entry_string.bytes );
+                    idx                      = wanted.find( co_await read( bytes_pointer, entry_string.size ) );
+                }
+            }
+            else
+                idx = wanted.find( entry_string.bytes, entry_string.size );
+
+            if ( idx != std::string_view::npos )
+                results[ idx ] = hash_entry.get_set;
+
+            if ( bucket_nodes.current == bucket_nodes.first or !hash_entry.forward )
+                break;
+
+            bucket_nodes.current = hash_entry.forward;
+        }
+    }
+
+    void c_lookup_engine::schedule( std::size_t count, const std::function< lookup_task_t( std::size_t ) > &spawn ) noexcept
+    {
+        std::vector< lookup_task_t > active;
+        std::size_t                  next { 0 };
+
+        while ( true )
+        {
+            // top the in-flight set up, each new walk runs until its first read
+            while ( active.size( ) < m_concurrency and next < count )
+            {
+                active.push_back( spawn( next ) );
+                active.back( ).handle.resume( );
+                ++next;
+            }
+
+            std::erase_if( active,
+                           []( const lookup_task_t &task )
+                           {
+                               return task.handle.done( );
+                           } );
+
+            if ( m_pending.empty( ) )
+            {
+                if ( next < count )
+                    continue;
+
+                break;
+            }
+
+            const auto pending = std::exchange( m_pending, { } );
+
+            std::vector< read_request_t > requests;
+            requests.reserve( pending.size( ) );
+
+            for ( const auto *entry : pending )
+                requests.push_back( entry->request );
+
+            m_stats.syscalls += g_memory->read_batch( requests );
+            m_stats.reads += requests.size( );
+            ++m_stats.ticks;
+
+            for ( std::size_t idx = 0; idx < pending.size( ); ++idx )
+            {
+                pending[ idx ]->request.result = requests[ idx ].result;
+                pending[ idx ]->handle.resume( );
+            }
+        }
+    }
+
+    std::vector< std::uint64_t > c_lookup_engine::run( std::span< const std::string > names ) noexcept
+    {
+        std::vector< std::uint64_t > results( names.size( ), 0 );
+
+        m_stats = { .lookups = names.size( ) };
+
+        if ( names.empty( ) )
+            return results;
+
+        const auto header = m_fflags.table( );
+        if ( !header )
+            return results;
+
+        const auto &table   = *header;
+        const auto  buckets = table.mask + 1;
+
+        // with more names than buckets nearly every chain is walked anyway, so walk each chain once and match every node
+        // against all names instead of walking a chain once per name
+        if ( names.size( ) > buckets )
+        {
+            const c_name_set wanted( names );
+
+            schedule( buckets,
+                      [ & ]( std::size_t bucket )
+                      {
+                          return sweep( bucket, table, wanted, results );
+                      } );
+
+            for ( std::size_t idx = 0; idx < names.size( ); ++idx )
+                results[ idx ] = results[ wanted.first( idx ) ];
+
+            return results;
+        }
+
+        const std::vector< c_name > needles( names.begin( ), names.end( ) );
+
+        schedule( names.size( ),
+                  [ & ]( std::size_t idx )
+                  {
+                      return walk( needles[ idx ], table, results[ idx ] );
+                  } );
+
+        return results;
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "targets/target.hpp"
+
+// local->engine
+#include "names/names.hpp"
+
+namespace odessa::engine
+{
+    class c_fflags;
+    struct hash_map_t;
+
+    struct lookup_stats_t
+    {
+        std::uint64_t lookups { 0 };  ///< Number of names looked up
+        std::uint64_t ticks { 0 };    ///< Scheduler ticks, i.e. batched round trips to the target
+        std::uint64_t reads { 0 };    ///< Individual remote reads requested by the walks
+        std::uint64_t syscalls { 0 }; ///< Reads issued to the target after coalescing
+
+        /**
+         * @brief Accumulates the counters of another run.
+         *
+         * @param other The counters to add.
+         *
+         * @return A reference to this object.
+         */
+        lookup_stats_t &operator+=( const lookup_stats_t &other ) noexcept
+        {
+            lookups += other.lookups;
+            ticks += other.ticks;
+            reads += other.reads;
+            syscalls += other.syscalls;
+
+            return *this;
+        }
+    };
+
+    struct lookup_task_t
+    {
+        struct promise_type
+        {
+            lookup_task_t get_return_object( ) noexcept
+            {
+                return lookup_task_t { std::coroutine_handle< promise_type >::from_promise( *this ) };
+            }
+
+            std::suspend_always initial_suspend( ) noexcept
+            {
+                return { };
+            }
+
+            std::suspend_always final_suspend( ) noexcept
+            {
+                return { };
+            }
+
+            void return_void( ) noexcept { }
+
+            void unhandled_exception( ) noexcept
+            {
+                std::terminate( );
+            }
+        };
+
+        std::coroutine_handle< promise_type > handle { nullptr }; ///< Handle to the suspended walk
+
+        explicit lookup_task_t( std::coroutine_handle< promise_type > coroutine ) noexcept : handle( coroutine ) { }
+
+        lookup_task_t( lookup_task_t &&other ) noexcept : handle( std::exchange( other.handle, nullptr ) ) { }
+
+        lookup_task_t( const lookup_task_t & )            = delete;
+        lookup_task_t &operator=( const lookup_task_t & ) = delete;
+
+        lookup_task_t &operator=( lookup_task_t &&other ) noexcept
+        {
+            if ( this != &other )
+            {
+                if ( handle )
+                    handle.destroy( );
+
+                handle = std::exchange( other.handle, nullptr );
+            }
+
+            return *this;
+        }
+
+        ~lookup_task_t( ) noexcept
+        {
+            if ( handle )
+                handle.destroy( );
+        }
+    };
+
+    class c_lookup_engine
+    {
+        struct pending_t
+        {
+            read_request_t          request { }; ///< The remote read the walk is waiting for
+            std::coroutine_handle<> handle { };  ///< The walk to resume once the read completes
+        };
+
+        template < typename type_t >
+        struct value_awaiter_t
+        {
+            c_lookup_engine *engine { nullptr }; ///< Scheduler the read is queued on
+            pending_t        pending { };        ///< Queued read
+            type_t           value { };          ///< Destination of the read
+
+            bool await_ready( ) const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend( std::coroutine_handle<> handle ) noexcept
+            {
+                pending.request.buffer = &value;
+                pending.request.size   = sizeof( type_t );
+                pending.handle         = handle;
+
+                engine->m_pending.push_back( &pending );
+            }
+
+            type_t await_resume( ) noexcept
+            {
+                return pending.request.result == sizeof( type_t ) ? value : type_t { };
+            }
+        };
+
+        struct bytes_awaiter_t
+        {
+            c_lookup_engine            *engine { nullptr }; ///< Scheduler the read is queued on
+            pending_t                   pending { };        ///< Queued read
+            std::vector< std::uint8_t > bytes { };          ///< Destination of the read
+
+            bool await_ready( ) const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend( std::coroutine_handle<> handle ) noexcept
+            {
+                pending.request.buffer = bytes.data( );
+                pending.request.size   = bytes.size( );
+                pending.handle         = handle;
+
+                engine->m_pending.push_back( &pending );
+            }
+
+            std::vector< std::uint8_t > await_resume( ) noexcept
+            {
+                bytes.resize( pending.request.result );
+                return std::move( bytes );
+            }
+        };
+
+        const c_fflags &m_fflags;                ///< FFlag manager providing the hash and table
+        std::size_t     m_concurrency { 256 };   ///< Maximum number of walks in flight
+        lookup_stats_t  m_stats { };             ///< Counters of the last run
+
+        std::vector< pending_t * > m_pending { }; ///< Reads queued for the next tick
+
+        /**
+         * @brief Queues a read of a trivially copyable remote value.
+         *
+         * @tparam type_t The type to read.
+         * @param address The remote address.
+         *
+         * @return An awaiter yielding the value, or a default-constructed value if the read fails.
+         */
+        template < typename type_t >
+        value_awaiter_t< type_t > read( std::uint64_t address ) noexcept
+        {
+            return { .engine = this, .pending = { .request = { .address = address } } };
+        }
+
+        /**
+         * @brief Queues a read of a remote byte buffer.
+         *
+         * @param address The remote address.
+         * @param size The number of bytes to read.
+         *
+         * @return An awaiter yielding the bytes actually read.
+         */
+        bytes_awaiter_t read( std::uint64_t address, std::size_t size ) noexcept
+        {
+            return { .engine = this, .pending = { .request = { .address = address } }, .bytes = std::vector< std::uint8_t >( size ) };
+        }
+
+        /**
+         * @brief Walks the bucket of one FFlag, suspending on every remote read.
+         *
+         * @param name The name of the FFlag, owned by the caller for the duration of run().
+         * @param table The hash table header.
+         * @param result Receives the address of the FFlag's GetSet, or 0 if it was not found.
+         */
+        lookup_task_t walk( const c_name &name, const hash_map_t &table, std::uint64_t &result ) noexcept;
+
+        /**
+         * @brief Walks one whole bucket, matching every node against a set of wanted names.
+         *
+         * @param bucket The index of the bucket.
+         * @param table The hash table header.
+         * @param wanted The names to look for.
+         * @param results Receives the address of each found FFlag's GetSet, at the index of its name.
+         */
+        lookup_task_t sweep( std::uint64_t bucket, const hash_map_t &table, const c_name_set &wanted,
+                             std::vector< std::uint64_t > &results ) noexcept;
+
+        /**
+         * @brief Runs walks, keeping up to the configured number in flight and batching their reads per tick.
+         *
+         * @param count The number of walks to run.
+         * @param spawn Creates the walk with the given index.
+         */
+        void schedule( std::size_t count, const std::function< lookup_task_t( std::size_t ) > &spawn ) noexcept;
+
+      public:
+        /**
+         * @brief Creates a lookup engine for an FFlag manager.
+         *
+         * @param fflags The FFlag manager providing the hash and table.
+         * @param concurrency The maximum number of walks kept in flight.
+         */
+        c_lookup_engine( const c_fflags &fflags, std::size_t concurrency = 256 ) noexcept :
+            m_fflags( fflags ), m_concurrency( std::max< std::size_t >( concurrency, 1 ) )
+        {
+        }
+
+        /**
+         * @brief Looks up every name, keeping up to the configured number of walks in flight.
+         *
+         * Each tick collects the reads all suspended walks are waiting on, issues them as one coalesced
+         * batch, and resumes the walks. The number of ticks tracks the longest bucket chain rather than
+         * the sum of all chains. With more names than buckets, every bucket is walked once instead and
+         * each node is matched against all names through a c_name_set.
+         *
+         * @param names The names to look up.
+         *
+         * @return The GetSet address of each name, in the same order, or 0 for missing names.
+         */
+        std::vector< std::uint64_t > run( std::span< const std::string > names ) noexcept;
+
+        /**
+         * @brief Returns the counters of the last run.
+         *
+         * @return The lookup counters.
+         */
+        [[nodiscard]] const lookup_stats_t &stats( ) const noexcept
+        {
+            return m_stats;
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
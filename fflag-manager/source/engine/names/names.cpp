@@ -0,0 +1,39 @@
+#include "names.hpp"
+
+namespace odessa::engine
+{
+    c_name::c_name( std::string_view name ) noexcept : m_name( name )
+    {
+        if ( name.size( ) > inline_capacity )
+            return;
+
+        std::memcpy( m_padded.data( ), name.data( ), name.size( ) );
+        m_mask = ( 1u << name.size( ) ) - 1;
+    }
+
+    c_name_set::c_name_set( std::span< const std::string > names ) noexcept
+    {
+        m_first.resize( names.size( ) );
+
+        for ( std::size_t idx = 0; idx < names.size( ); ++idx )
+        {
+            const auto &name = names[ idx ];
+
+            if ( name.size( ) <= inline_capacity )
+            {
+                std::array< std::uint8_t, 0x10 > padded { };
+                std::memcpy( padded.data( ), name.data( ), name.size( ) );
+
+                m_first[ idx ] = m_inline.try_emplace( key( padded.data( ), name.size( ) ), idx ).first->second;
+                continue;
+            }
+
+            m_first[ idx ] = m_heap.try_emplace( name, idx ).first->second;
+
+            if ( m_lengths.size( ) <= name.size( ) )
+                m_lengths.resize( name.size( ) + 1 );
+
+            m_lengths[ name.size( ) ] = true;
+        }
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "native.hpp"
+
+namespace odessa::engine
+{
+    constexpr std::uint64_t inline_capacity { 0xf }; ///< Longest name string_t keeps in its 16 byte inline buffer
+
+    class c_name
+    {
+        alignas( 16 ) std::array< std::uint8_t, 0x10 > m_padded { }; ///< Name zero-padded to the size of the inline buffer
+        std::uint32_t    m_mask { 0 };                              ///< One bit per significant byte of m_padded
+        std::string_view m_name { };                                ///< The name itself, owned by the caller
+
+      public:
+        /**
+         * @brief Prepares a name for matching against remote strings.
+         *
+         * @param name The name to match, which must outlive the object.
+         */
+        c_name( std::string_view name ) noexcept;
+
+        /**
+         * @brief Compares the name against the inline buffer of a remote string_t with a single masked SIMD compare.
+         *
+         * Bytes past the remote size are ignored, the client leaves whatever was there before in them.
+         *
+         * @param bytes The 16 byte inline buffer.
+         * @param size The size of the remote string.
+         *
+         * @return True if the remote string equals the name.
+         */
+        [[nodiscard]] bool matches( const std::uint8_t *bytes, std::uint64_t size ) const noexcept
+        {
+            if ( size != m_name.size( ) or size > inline_capacity )
+                return false;
+
+#ifdef ODESSA_SSE2
+            const auto remote = _mm_loadu_si128( reinterpret_cast< const __m128i * >( bytes ) );
+            const auto local  = _mm_load_si128( reinterpret_cast< const __m128i * >( m_padded.data( ) ) );
+            const auto equal  = static_cast< std::uint32_t >( _mm_movemask_epi8( _mm_cmpeq_epi8( remote, local ) ) );
+
+            return ( equal & m_mask ) == m_mask;
+#else
+            return std::memcmp( bytes, m_padded.data( ), size ) == 0;
+#endif
+        }
+
+        /**
+         * @brief Compares the name against heap name bytes, directly in the buffer they were read into.
+         *
+         * @param bytes The bytes of the remote name.
+         *
+         * @return True if the remote name equals the name.
+         */
+        [[nodiscard]] bool matches( std::span< const std::uint8_t > bytes ) const noexcept
+        {
+            return bytes.size( ) == m_name.size( ) and std::memcmp( bytes.data( ), m_name.data( ), bytes.size( ) ) == 0;
+        }
+
+        /**
+         * @brief Returns the name.
+         *
+         * @return A view of the name.
+         */
+        [[nodiscard]] std::string_view view( ) const noexcept
+        {
+            return m_name;
+        }
+    };
+
+    class c_name_set
+    {
+        struct inline_key_t
+        {
+            std::uint64_t low { 0 };  ///< Bytes 0-7 of the masked inline buffer
+            std::uint64_t high { 0 }; ///< Bytes 8-15 of the masked inline buffer, with the size in the last byte
+
+            bool operator==( const inline_key_t & ) const noexcept = default;
+        };
+
+        struct inline_hash_t
+        {
+            std::size_t operator( )( const inline_key_t &key ) const noexcept
+            {
+                return static_cast< std::size_t >( ( key.low ^ std::rotl( key.high, 29 ) ) * 0x9e3779b97f4a7c15 );
+            }
+        };
+
+        std::unordered_map< inline_key_t, std::size_t, inline_hash_t > m_inline { }; ///< Inline names, keyed by their masked buffer
+        std::unordered_map< std::string_view, std::size_t >            m_heap { };   ///< Heap names, keyed by their bytes
+        std::vector< bool >                                            m_lengths { }; ///< Whether a heap name of a given length is wanted
+        std::vector< std::size_t >                                     m_first { };  ///< Index of the first occurrence of each name
+
+        /**
+         * @brief Builds the key of an inline buffer, ignoring the bytes past the size.
+         *
+         * @param bytes The 16 byte inline buffer.
+         * @param size The size of the string, at most inline_capacity.
+         *
+         * @return The key.
+         */
+        [[nodiscard]] static inline_key_t key( const std::uint8_t *bytes, std::uint64_t size ) noexcept
+        {
+            inline_key_t result;
+
+#ifdef ODESSA_SSE2
+            const auto indices = _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+            const auto keep    = _mm_cmplt_epi8( indices, _mm_set1_epi8( static_cast< char >( size ) ) );
+            const auto masked  = _mm_and_si128( _mm_loadu_si128( reinterpret_cast< const __m128i * >( bytes ) ), keep );
+
+            _mm_storeu_si128( reinterpret_cast< __m128i * >( &result ), masked );
+#else
+            std::memcpy( &result, bytes, size );
+#endif
+
+            // the last byte is never significant, so it can carry the size and tell "a" from "a\0"
+            result.high |= size << 56;
+            return result;
+        }
+
+      public:
+        /**
+         * @brief Indexes a set of wanted names.
+         *
+         * @param names The names, which must outlive the object.
+         */
+        c_name_set( std::span< const std::string > names ) noexcept;
+
+        /**
+         * @brief Looks up the inline buffer of a remote string_t.
+         *
+         * @param bytes The 16 byte inline buffer.
+         * @param size The size of the remote string.
+         *
+         * @return The index of the matching name, or std::string_view::npos.
+         */
+        [[nodiscard]] std::size_t find( const std::uint8_t *bytes, std::uint64_t size ) const noexcept
+        {
+            if ( size > inline_capacity or m_inline.empty( ) )
+                return std::string_view::npos;
+
+            const auto it = m_inline.find( key( bytes, size ) );
+            return it != m_inline.end( ) ? it->second : std::string_view::npos;
+        }
+
+        /**
+         * @brief Looks up heap name bytes, directly in the buffer they were read into.
+         *
+         * @param bytes The bytes of the remote name.
+         *
+         * @return The index of the matching name, or std::string_view::npos.
+         */
+        [[nodiscard]] std::size_t find( std::span< const std::uint8_t > bytes ) const noexcept
+        {
+            const auto it = m_heap.find( std::string_view( reinterpret_cast< const char * >( bytes.data( ) ), bytes.size( ) ) );
+            return it != m_heap.end( ) ? it->second : std::string_view::npos;
+        }
+
+        /**
+         * @brief Checks whether a heap name of the given length could match, so the caller can skip reading it.
+         *
+         * @param size The size of the remote name.
+         *
+         * @return True if some wanted heap name has this length.
+         */
+        [[nodiscard]] bool wants( std::uint64_t size ) const noexcept
+        {
+            return size < m_lengths.size( ) and m_lengths[ size ];
+        }
+
+        /**
+         * @brief Returns the index of the first occurrence of a name, so duplicates can share a result.
+         *
+         * @param idx The index of the name.
+         *
+         * @return The index of the first equal name.
+         */
+        [[nodiscard]] std::size_t first( std::size_t idx ) const noexcept
+        {
+            return m_first[ idx ];
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "pending.hpp"
+
+namespace odessa::engine
+{
+    c_pending::c_pending( std::vector< entry_t > entries ) noexcept
+    {
+        m_table = g_fflags->table( ).value_or( hash_map_t { } );
+        m_pending.reserve( entries.size( ) );
+
+        // a FFlag registered between the lookup that missed it and the header read above is already part of the baseline,
+        // so every bucket is walked once by the first poll
+        for ( auto &entry : entries )
+        {
+            const auto hash = g_fflags->hash( entry.name );
+            m_pending.push_back( { .entry = std::move( entry ), .hash = hash, .bucket = hash & m_table.mask, .dirty = true } );
+        }
+
+        sample( false );
+    }
+
+    void c_pending::sample( bool mark ) noexcept
+    {
+        std::vector< nodes_t >        nodes( m_pending.size( ) );
+        std::vector< read_request_t > requests;
+        requests.reserve( m_pending.size( ) );
+
+        for ( std::size_t idx = 0; idx < m_pending.size( ); ++idx )
+        {
+            requests.push_back( { .address = m_table.list + m_pending[ idx ].bucket * sizeof( nodes_t ),
+                                  .buffer  = &nodes[ idx ],
+                                  .size    = sizeof( nodes_t ) } );
+        }
+
+        g_memory->read_batch( requests );
+
+        for ( std::size_t idx = 0; idx < m_pending.size( ); ++idx )
+        {
+            auto &pending = m_pending[ idx ];
+
+            if ( requests[ idx ].result != sizeof( nodes_t ) )
+                continue;
+
+            if ( mark and ( nodes[ idx ].first != pending.nodes.first or nodes[ idx ].current != pending.nodes.current ) )
+                pending.dirty = true;
+
+            pending.nodes = nodes[ idx ];
+        }
+    }
+
+    void c_pending::walk( const resolver_t &resolve, const applier_t &apply, std::chrono::steady_clock::time_point start ) noexcept
+    {
+        std::vector< std::size_t > dirty;
+
+        for ( std::size_t idx = 0; idx < m_pending.size( ); ++idx )
+        {
+            if ( m_pending[ idx ].dirty )
+                dirty.push_back( idx );
+        }
+
+        for ( std::size_t offset = 0; offset < dirty.size( ); offset += walk_batch )
+        {
+            const auto batch = std::span( dirty ).subspan( offset, std::min( walk_batch, dirty.size( ) - offset ) );
+
+            std::vector< std::string > names;
+            names.reserve( batch.size( ) );
+
+            for ( const auto idx : batch )
+                names.push_back( m_pending[ idx ].entry.name );
+
+            const auto fflags = resolve( names );
+
+            for ( std::size_t idx = 0; idx < batch.size( ); ++idx )
+            {
+                auto &pending = m_pending[ batch[ idx ] ];
+
+                pending.dirty = false;
+                ++m_stats.walks;
+
+                if ( !fflags[ idx ] )
+                    continue;
+
+                apply( pending.entry, fflags[ idx ] );
+
+                pending.applied = true;
+                ++m_stats.applied;
+            }
+
+            // the remaining dirty buckets are picked up by the next poll, which comes right away since the table changed
+            if ( std::chrono::steady_clock::now( ) - start > poll_budget )
+                break;
+        }
+
+        std::erase_if( m_pending,
+                       []( const pending_t &pending )
+                       {
+                           return pending.applied;
+                       } );
+    }
+
+    bool c_pending::poll( const resolver_t &resolve, const applier_t &apply ) noexcept
+    {
+        const auto start = std::chrono::steady_clock::now( );
+
+        ++m_stats.polls;
+
+        // the header is all that is read while nothing changes, a batch reads it past the page cache and leaves the cache alone
+        hash_map_t     table { };
+        read_request_t header { .address = g_fflags->singleton( ) + sizeof( void * ), .buffer = &table, .size = sizeof( hash_map_t ) };
+
+        g_memory->read_batch( std::span( &header, 1 ) );
+
+        const auto dirty = std::ranges::any_of( m_pending, &pending_t::dirty );
+
+        const bool rehashed = table.mask != m_table.mask or table.list != m_table.list;
+        const bool changed  = rehashed or table.size != m_table.size;
+
+        // a table that reads as empty is being torn down or rebuilt, wait for it to settle
+        if ( ( !changed and !dirty ) or table.mask == 0 or table.list == 0 )
+        {
+            m_stats.busy += std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now( ) - start ).count( );
+            return false;
+        }
+
+        if ( changed )
+        {
+            ++m_stats.changes;
+            m_table = table;
+        }
+
+        if ( rehashed )
+        {
+            ++m_stats.rehashes;
+
+            for ( auto &pending : m_pending )
+            {
+                pending.bucket = pending.hash & m_table.mask;
+                pending.dirty  = true;
+            }
+
+            sample( false );
+        }
+        else if ( changed )
+            sample( true );
+
+        // the walk goes through the page cache, which still holds the buckets as they were before the change
+        g_memory->invalidate( );
+
+        walk( resolve, apply, start );
+
+        m_stats.busy += std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now( ) - start ).count( );
+        return true;
+    }
+
+    void c_pending::watch( std::chrono::milliseconds timeout, const resolver_t &resolve, const applier_t &apply ) noexcept
+    {
+        const auto start    = std::chrono::steady_clock::now( );
+        auto       interval = std::chrono::milliseconds( min_interval );
+
+        while ( !empty( ) and g_memory->target( ).alive( ) )
+        {
+            // compared in milliseconds so that milliseconds::max( ) watches until the client exits
+            const auto elapsed = std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now( ) - start );
+            if ( elapsed >= timeout )
+                break;
+
+            std::this_thread::sleep_for( std::min( interval, timeout - elapsed ) );
+
+            interval = poll( resolve, apply ) ? min_interval : std::min( interval * 2, max_interval );
+        }
+    }
+
+    std::vector< entry_t > c_pending::remaining( ) const noexcept
+    {
+        std::vector< entry_t > entries;
+        entries.reserve( m_pending.size( ) );
+
+        for ( const auto &pending : m_pending )
+            entries.push_back( pending.entry );
+
+        return entries;
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->engine
+#include "engine.hpp"
+
+namespace odessa::engine
+{
+    struct pending_stats_t
+    {
+        std::uint64_t polls { 0 };    ///< Table headers read
+        std::uint64_t changes { 0 };  ///< Polls that found the table changed
+        std::uint64_t rehashes { 0 }; ///< Changes that moved every bucket
+        std::uint64_t walks { 0 };    ///< Buckets re-walked
+        std::uint64_t applied { 0 };  ///< FFlags applied after they appeared
+
+        double busy { 0.0 }; ///< Time spent polling and walking, excluding the sleeps in between, in milliseconds
+    };
+
+    class c_pending
+    {
+        static constexpr std::chrono::milliseconds min_interval { 50 };  ///< Poll interval right after the table changed
+        static constexpr std::chrono::milliseconds max_interval { 1000 }; ///< Poll interval the backoff settles at
+        static constexpr std::chrono::microseconds poll_budget { 2000 };  ///< Walking time after which a poll defers the rest
+        static constexpr std::size_t               walk_batch { 32 };     ///< Names walked together between budget checks
+
+        struct pending_t
+        {
+            entry_t       entry;             ///< The entry to apply once its FFlag appears
+            std::uint64_t hash { 0 };        ///< Hash of the FFlag name
+            std::uint64_t bucket { 0 };      ///< Bucket the name hashes to under the current mask
+            nodes_t       nodes { };         ///< Last seen bucket head
+            bool          dirty { false };   ///< Whether the bucket changed since it was last walked
+            bool          applied { false }; ///< Whether the FFlag appeared and was applied
+        };
+
+        std::vector< pending_t > m_pending { }; ///< FFlags that were not in the table yet
+        hash_map_t               m_table { };   ///< Last seen table header
+
+        pending_stats_t m_stats { }; ///< Counters reported by stats()
+
+        /**
+         * @brief Reads the bucket head of every pending FFlag in one batch.
+         *
+         * @param mark Whether FFlags whose bucket head changed should be marked dirty.
+         */
+        void sample( bool mark ) noexcept;
+
+        /**
+         * @brief Re-walks dirty buckets until they are all clean or the poll budget is spent.
+         *
+         * @param resolve Looks up the FFlags of dirty buckets.
+         * @param apply Called for every FFlag that appeared.
+         * @param start When the poll started.
+         */
+        void walk( const resolver_t &resolve, const applier_t &apply, std::chrono::steady_clock::time_point start ) noexcept;
+
+      public:
+        /**
+         * @brief Starts watching for FFlags that were missing from the table. The table must be readable.
+         *
+         * Every FFlag starts out dirty, the first poll walks its bucket once whether or not the table changed.
+         *
+         * @param entries The entries whose FFlags were not found.
+         */
+        c_pending( std::vector< entry_t > entries ) noexcept;
+
+        /**
+         * @brief Checks the table once and applies every pending FFlag that appeared.
+         *
+         * Only the table's size, mask and list are read while nothing changes. A new size re-reads the bucket
+         * heads of the pending FFlags and re-walks the buckets that changed, a new mask or list means the table
+         * was rehashed and every pending FFlag moved to a new bucket.
+         *
+         * @param resolve Looks up the FFlags of changed buckets.
+         * @param apply Called for every FFlag that appeared.
+         *
+         * @return True if any bucket was walked, false otherwise.
+         */
+        bool poll( const resolver_t &resolve, const applier_t &apply ) noexcept;
+
+        /**
+         * @brief Polls with exponential backoff until every FFlag appeared, the timeout passed or the client exited.
+         *
+         * @param timeout How long to watch for, std::chrono::milliseconds::max( ) to watch until the client exits.
+         * @param resolve Looks up the FFlags of changed buckets.
+         * @param apply Called for every FFlag that appeared.
+         */
+        void watch( std::chrono::milliseconds timeout, const resolver_t &resolve, const applier_t &apply ) noexcept;
+
+        /**
+         * @brief Returns the entries whose FFlags have not appeared yet.
+         *
+         * @return The entries, in the order they were given.
+         */
+        [[nodiscard]] std::vector< entry_t > remaining( ) const noexcept;
+
+        /**
+         * @brief Checks whether every FFlag appeared.
+         *
+         * @return True if nothing is pending, false otherwise.
+         */
+        [[nodiscard]] bool empty( ) const noexcept
+        {
+            return m_pending.empty( );
+        }
+
+        /**
+         * @brief Returns the watcher counters.
+         *
+         * @return The counters.
+         */
+        [[nodiscard]] const pending_stats_t &stats( ) const noexcept
+        {
+            return m_stats;
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
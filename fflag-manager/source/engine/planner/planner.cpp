@@ -0,0 +1,178 @@
+#include "planner.hpp"
+
+// local->misc
+#include "logger/logger.hpp"
+
+namespace odessa::engine
+{
+    void c_write_planner::stage( std::size_t owner, const c_remote_fflag &fflag, std::int32_t value ) noexcept
+    {
+        m_owners[ owner ] = m_staged.size( );
+        m_staged.push_back( { .owner = owner, .address = reinterpret_cast< std::uint64_t >( fflag->value ), .integer = value } );
+    }
+
+    void c_write_planner::stage( std::size_t owner, const c_remote_fflag &fflag, std::string value ) noexcept
+    {
+        m_owners[ owner ] = m_staged.size( );
+        m_staged.push_back( { .owner     = owner,
+                              .address   = reinterpret_cast< std::uint64_t >( fflag->value ),
+                              .is_string = true,
+                              .string    = std::move( value ) } );
+    }
+
+    std::vector< c_write_planner::range_t > c_write_planner::ranges( ) noexcept
+    {
+        std::vector< std::size_t >    strings;
+        std::vector< string_t >       headers;
+        std::vector< read_request_t > requests;
+
+        for ( std::size_t idx = 0; idx < m_staged.size( ); ++idx )
+        {
+            if ( m_staged[ idx ].is_string )
+                strings.push_back( idx );
+        }
+
+        headers.resize( strings.size( ) );
+
+        for ( std::size_t idx = 0; idx < strings.size( ); ++idx )
+            requests.push_back( { .address = m_staged[ strings[ idx ] ].address, .buffer = &headers[ idx ], .size = sizeof( string_t ) } );
+
+        g_memory->read_batch( requests );
+
+        std::vector< range_t > ranges;
+        std::size_t            next = 0;
+
+        for ( std::size_t idx = 0; idx < m_staged.size( ); ++idx )
+        {
+            auto &staged = m_staged[ idx ];
+
+            if ( !staged.is_string )
+            {
+                const auto *bytes = reinterpret_cast< const std::uint8_t * >( &staged.integer );
+
+                ranges.push_back( { .staged = idx, .address = staged.address, .bytes = { bytes, bytes + sizeof( std::int32_t ) } } );
+                continue;
+            }
+
+            const auto &request = requests[ next ];
+            auto        header  = headers[ next++ ];
+            const auto  length  = staged.string.length( );
+
+            // the client owns the buffer, a longer string would need a new allocation inside the client
+            if ( request.result != sizeof( string_t ) or header.size > header.allocation or length > header.allocation )
+            {
+                staged.failed = true;
+                continue;
+            }
+
+            header.size = length;
+
+            if ( header.allocation <= inline_capacity )
+            {
+                // the inline buffer and the size are adjacent, one range covers both
+                std::memcpy( header.bytes, staged.string.c_str( ), length + 1 );
+
+                const auto *bytes = reinterpret_cast< const std::uint8_t * >( &header );
+                const auto  end   = bytes + offsetof( string_t, allocation );
+
+                ranges.push_back( { .staged = idx, .address = staged.address, .bytes = { bytes, end } } );
+                continue;
+            }
+
+            const auto  buffer = *reinterpret_cast< const std::uint64_t * >( header.bytes );
+            const auto  field  = staged.address + offsetof( string_t, size );
+            const auto *text   = reinterpret_cast< const std::uint8_t * >( staged.string.c_str( ) );
+            const auto *size   = reinterpret_cast< const std::uint8_t * >( &header.size );
+
+            ranges.push_back( { .staged = idx, .address = buffer, .bytes = { text, text + length + 1 } } );
+            ranges.push_back( { .staged = idx, .address = field, .bytes = { size, size + sizeof( header.size ) } } );
+        }
+
+        return ranges;
+    }
+
+    std::vector< bool > c_write_planner::compare( std::span< const range_t > ranges ) noexcept
+    {
+        std::vector< std::vector< std::uint8_t > > current( ranges.size( ) );
+        std::vector< read_request_t >              requests( ranges.size( ) );
+
+        for ( std::size_t idx = 0; idx < ranges.size( ); ++idx )
+        {
+            current[ idx ].resize( ranges[ idx ].bytes.size( ) );
+            requests[ idx ] = { .address = ranges[ idx ].address, .buffer = current[ idx ].data( ), .size = current[ idx ].size( ) };
+        }
+
+        // read_batch goes straight to the target, a value the client changed since it was cached is still seen
+        g_memory->read_batch( requests );
+
+        std::vector< bool > matches( ranges.size( ) );
+
+        for ( std::size_t idx = 0; idx < ranges.size( ); ++idx )
+            matches[ idx ] = requests[ idx ].result == requests[ idx ].size and current[ idx ] == ranges[ idx ].bytes;
+
+        return matches;
+    }
+
+    void c_write_planner::commit( ) noexcept
+    {
+        m_stats = { .planned = m_staged.size( ) };
+
+        const auto all     = ranges( );
+        const auto matches = compare( all );
+
+        std::vector< range_t >     pending;
+        std::vector< std::size_t > touched( m_staged.size( ), 0 );
+
+        for ( std::size_t idx = 0; idx < all.size( ); ++idx )
+        {
+            if ( matches[ idx ] )
+                continue;
+
+            ++touched[ all[ idx ].staged ];
+            pending.push_back( all[ idx ] );
+        }
+
+        for ( std::size_t idx = 0; idx < m_staged.size( ); ++idx )
+        {
+            if ( !m_staged[ idx ].failed and !touched[ idx ] )
+                ++m_stats.skipped;
+        }
+
+        m_stats.ranges = pending.size( );
+
+        if ( pending.empty( ) )
+            return;
+
+        std::vector< write_request_t > requests;
+        requests.reserve( pending.size( ) );
+
+        for ( const auto &range : pending )
+            requests.push_back( { .address = range.address, .buffer = range.bytes.data( ), .size = range.bytes.size( ) } );
+
+        m_stats.syscalls = g_memory->write_batch( requests );
+
+        const auto verified = compare( pending );
+
+        for ( std::size_t idx = 0; idx < pending.size( ); ++idx )
+        {
+            auto &staged = m_staged[ pending[ idx ].staged ];
+
+            if ( verified[ idx ] or staged.failed )
+                continue;
+
+            if ( requests[ idx ].written )
+            {
+                ++m_stats.mismatched;
+                g_logger->debug( "{:#x} did not read back as written", pending[ idx ].address );
+            }
+
+            staged.failed = true;
+        }
+    }
+
+    bool c_write_planner::written( std::size_t owner ) const noexcept
+    {
+        const auto it = m_owners.find( owner );
+        return it != m_owners.end( ) and !m_staged[ it->second ].failed;
+    }
+} // namespace odessa::engine
\ No newline at end of file
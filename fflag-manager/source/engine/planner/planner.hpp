@@ -0,0 +1,125 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->engine
+#include "fflags/fflags.hpp"
+
+namespace odessa::engine
+{
+    struct write_stats_t
+    {
+        std::uint64_t planned { 0 };    ///< Values staged
+        std::uint64_t skipped { 0 };    ///< Values that already held the staged bytes and were not written
+        std::uint64_t ranges { 0 };     ///< Ranges left to write after comparing
+        std::uint64_t syscalls { 0 };   ///< Writes issued to the target after merging
+        std::uint64_t mismatched { 0 }; ///< Values that did not read back as written
+
+        /**
+         * @brief Accumulates the counters of another plan.
+         *
+         * @param other The counters to add.
+         *
+         * @return A reference to this object.
+         */
+        write_stats_t &operator+=( const write_stats_t &other ) noexcept
+        {
+            planned += other.planned;
+            skipped += other.skipped;
+            ranges += other.ranges;
+            syscalls += other.syscalls;
+            mismatched += other.mismatched;
+
+            return *this;
+        }
+    };
+
+    class c_write_planner
+    {
+        struct staged_t
+        {
+            std::size_t   owner { 0 };         ///< Caller's index of the value
+            std::uint64_t address { 0 };       ///< Address of the FFlag's value
+            bool          is_string { false }; ///< Whether the value is written through a string_t
+            std::int32_t  integer { 0 };       ///< Value of integer, flag and log FFlags
+            std::string   string { };          ///< Value of string FFlags
+            bool          failed { false };    ///< Whether the value could not be written or verified
+        };
+
+        struct range_t
+        {
+            std::size_t                 staged { 0 };  ///< Index of the staged value the range belongs to
+            std::uint64_t               address { 0 }; ///< Address of the range
+            std::vector< std::uint8_t > bytes { };     ///< Bytes the range has to hold
+        };
+
+        std::vector< staged_t >                        m_staged { }; ///< Values staged for commit()
+        std::unordered_map< std::size_t, std::size_t > m_owners { }; ///< Index into m_staged of every owner
+        write_stats_t                                  m_stats { };  ///< Counters of commit()
+
+        /**
+         * @brief Turns the staged values into the ranges they write, reading the headers of string values as one batch.
+         *
+         * @return The ranges, in staging order.
+         */
+        std::vector< range_t > ranges( ) noexcept;
+
+        /**
+         * @brief Reads every range back as one batch and compares it with the bytes it has to hold.
+         *
+         * @param ranges The ranges to compare.
+         *
+         * @return One flag per range, true where the range already holds its bytes.
+         */
+        static std::vector< bool > compare( std::span< const range_t > ranges ) noexcept;
+
+      public:
+        /**
+         * @brief Stages an integer, flag or log value.
+         *
+         * @param owner Caller's index of the value, used to query written().
+         * @param fflag The resolved FFlag.
+         * @param value The value to write.
+         */
+        void stage( std::size_t owner, const c_remote_fflag &fflag, std::int32_t value ) noexcept;
+
+        /**
+         * @brief Stages a string value.
+         *
+         * The string is written into the FFlag's existing buffer, inline or on the heap, and must fit its capacity.
+         *
+         * @param owner Caller's index of the value, used to query written().
+         * @param fflag The resolved FFlag.
+         * @param value The value to write.
+         */
+        void stage( std::size_t owner, const c_remote_fflag &fflag, std::string value ) noexcept;
+
+        /**
+         * @brief Writes every staged value.
+         *
+         * Reads the current bytes of every range in one batch and drops the ranges that already hold their bytes.
+         * The rest are merged into contiguous spans by c_memory::write_batch and read back in one more batch to verify
+         * them. A planner commits once, use one per batch.
+         */
+        void commit( ) noexcept;
+
+        /**
+         * @brief Checks whether a staged value was written and read back, or already held its bytes.
+         *
+         * @param owner Caller's index of the value.
+         *
+         * @return True if the value holds what was staged, false if it failed or was never staged.
+         */
+        [[nodiscard]] bool written( std::size_t owner ) const noexcept;
+
+        /**
+         * @brief Returns the counters of commit().
+         *
+         * @return The counters.
+         */
+        [[nodiscard]] const write_stats_t &stats( ) const noexcept
+        {
+            return m_stats;
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
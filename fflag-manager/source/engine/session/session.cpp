@@ -0,0 +1,179 @@
+#include "session.hpp"
+
+namespace odessa::engine
+{
+    namespace
+    {
+        std::mutex g_session_mutex; ///< Serializes sessions, only one can own g_memory and g_fflags at a time
+
+        class c_scope
+        {
+            std::scoped_lock< std::mutex > m_lock; ///< Held for the lifetime of the scope
+
+            std::unique_ptr< c_memory > &m_memory; ///< The session's memory, swapped with g_memory
+            std::unique_ptr< c_fflags > &m_fflags; ///< The session's FFlag manager, swapped with g_fflags
+
+          public:
+            /**
+             * @brief Installs a session's client as g_memory and g_fflags.
+             */
+            c_scope( std::unique_ptr< c_memory > &memory, std::unique_ptr< c_fflags > &fflags ) noexcept :
+                m_lock( g_session_mutex ), m_memory( memory ), m_fflags( fflags )
+            {
+                std::swap( g_memory, m_memory );
+                std::swap( g_fflags, m_fflags );
+            }
+
+            /**
+             * @brief Hands the client back to the session, including one created or released in the scope.
+             */
+            ~c_scope( ) noexcept
+            {
+                std::swap( g_memory, m_memory );
+                std::swap( g_fflags, m_fflags );
+            }
+        };
+    } // namespace
+
+    c_session::~c_session( ) noexcept
+    {
+        detach( );
+    }
+
+    e_attach_status c_session::attach( std::chrono::milliseconds timeout ) noexcept
+    {
+        detach( );
+
+        auto memory = m_supervisor.find( timeout );
+        if ( !memory )
+            return e_attach_status::not_found;
+
+        // locating may wait for another instance scanning the same build and then scan, only installing needs the turn
+        auto       fflags = m_supervisor.locate( *memory );
+        const auto found  = fflags->singleton( ) != 0;
+
+        c_scope scope( m_memory, m_fflags );
+
+        m_supervisor.attach( std::move( memory ), std::move( fflags ) );
+
+        return found ? e_attach_status::ok : e_attach_status::no_table;
+    }
+
+    std::vector< const c_remote_fflag * > c_session::lookup( std::span< const entry_t > entries ) noexcept
+    {
+        std::vector< const c_remote_fflag * > results( entries.size( ), nullptr );
+        std::vector< std::string >            missing;
+
+        if ( !g_fflags or !g_fflags->singleton( ) )
+            return results;
+
+        for ( const auto &entry : entries )
+        {
+            if ( !m_resolved.contains( entry.name ) and std::ranges::find( missing, entry.name ) == missing.end( ) )
+                missing.push_back( entry.name );
+        }
+
+        if ( !missing.empty( ) )
+        {
+            auto found = m_supervisor.resolve( missing );
+
+            for ( std::size_t idx = 0; idx < missing.size( ); ++idx )
+            {
+                if ( found[ idx ] )
+                    m_resolved.try_emplace( missing[ idx ], std::move( found[ idx ] ) );
+            }
+        }
+
+        for ( std::size_t idx = 0; idx < entries.size( ); ++idx )
+        {
+            if ( const auto it = m_resolved.find( entries[ idx ].name ); it != m_resolved.end( ) )
+                results[ idx ] = &it->second;
+        }
+
+        return results;
+    }
+
+    e_call_status c_session::ready( ) noexcept
+    {
+        const auto started = std::chrono::steady_clock::now( );
+
+        while ( true )
+        {
+            {
+                c_scope scope( m_memory, m_fflags );
+
+                if ( !g_fflags or !g_fflags->singleton( ) )
+                    return e_call_status::not_attached;
+
+                if ( g_fflags->table( std::chrono::milliseconds::zero( ) ) )
+                    return e_call_status::ok;
+
+                if ( !g_memory->target( ).alive( ) )
+                    return e_call_status::not_attached;
+            }
+
+            if ( c_target::expired( started, table_timeout ) )
+                return e_call_status::not_ready;
+
+            std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        }
+    }
+
+    e_call_status c_session::resolve( std::span< const entry_t > entries, std::vector< e_apply_status > &statuses ) noexcept
+    {
+        if ( const auto status = ready( ); status != e_call_status::ok )
+            return status;
+
+        c_scope scope( m_memory, m_fflags );
+
+        statuses.clear( );
+        statuses.reserve( entries.size( ) );
+
+        for ( const auto *fflag : lookup( entries ) )
+            statuses.push_back( fflag ? e_apply_status::ok : e_apply_status::missing );
+
+        return e_call_status::ok;
+    }
+
+    e_call_status c_session::apply( std::span< const entry_t > entries, std::vector< e_apply_status > &statuses ) noexcept
+    {
+        if ( const auto status = ready( ); status != e_call_status::ok )
+            return status;
+
+        c_scope scope( m_memory, m_fflags );
+
+        const auto    fflags = lookup( entries );
+        write_stats_t stats { };
+
+        statuses = apply_batch( entries, fflags, stats );
+
+        return e_call_status::ok;
+    }
+
+    e_call_status c_session::snapshot( std::span< const entry_t > entries, std::vector< std::optional< std::string > > &values ) noexcept
+    {
+        if ( const auto status = ready( ); status != e_call_status::ok )
+            return status;
+
+        c_scope scope( m_memory, m_fflags );
+
+        // the client may have changed its values since the last call
+        g_memory->invalidate( );
+
+        values.clear( );
+        values.reserve( entries.size( ) );
+
+        for ( const auto *fflag : lookup( entries ) )
+            values.push_back( fflag ? fflag->read( ) : std::nullopt );
+
+        return e_call_status::ok;
+    }
+
+    void c_session::detach( ) noexcept
+    {
+        c_scope scope( m_memory, m_fflags );
+
+        m_resolved.clear( );
+        m_supervisor.release( );
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->engine
+#include "engine.hpp"
+#include "supervisor/supervisor.hpp"
+
+namespace odessa::engine
+{
+    enum class e_attach_status : std::uint8_t
+    {
+        ok        = 0, ///< Attached and the FFlag table was located
+        not_found = 1, ///< The client was not running, or had no window, before the timeout
+        no_table  = 2  ///< Attached, but the FFlag table was not located
+    };
+
+    enum class e_call_status : std::uint8_t
+    {
+        ok           = 0, ///< The call went through, see the per entry results
+        not_attached = 1, ///< No client is attached, or the attached client exited
+        not_ready    = 2  ///< The client did not populate its FFlag table before the timeout
+    };
+
+    class c_session
+    {
+        static constexpr std::chrono::milliseconds table_timeout { 10000 }; ///< How long a call waits for the FFlag table
+
+        c_supervisor m_supervisor { }; ///< Keeps the singleton and image-relative GetSet offsets across client restarts
+
+        std::unique_ptr< c_memory > m_memory { nullptr }; ///< Memory of the attached client, installed as g_memory during calls
+        std::unique_ptr< c_fflags > m_fflags { nullptr }; ///< FFlag manager of the attached client, installed as g_fflags during calls
+
+        std::unordered_map< std::string, c_remote_fflag > m_resolved { }; ///< FFlags resolved for the attached client, by name
+
+        /**
+         * @brief Resolves FFlags, looking up only the names that are not resolved yet. Must be called in a scope.
+         *
+         * @param entries The entries whose FFlags to resolve.
+         *
+         * @return One pointer into m_resolved per entry, or nullptr if the FFlag does not exist.
+         */
+        std::vector< const c_remote_fflag * > lookup( std::span< const entry_t > entries ) noexcept;
+
+        /**
+         * @brief Waits until the client has populated its FFlag table. Other sessions keep working between polls.
+         *
+         * @return ok once the table is readable, otherwise why the call cannot go through.
+         */
+        e_call_status ready( ) noexcept;
+
+      public:
+        /**
+         * @brief Releases the attached client, if any.
+         */
+        ~c_session( ) noexcept;
+
+        /**
+         * @brief Waits for the client and attaches to it, releasing any previously attached instance first.
+         *
+         * The engine works on g_memory and g_fflags, so every call installs the session's client into them for its
+         * duration and sessions take turns process-wide. Waiting for the client and locating its FFlag table happen
+         * outside of that, other sessions keep working meanwhile. A session itself must not be used by two threads
+         * at once.
+         *
+         * @param timeout How long to wait for the client.
+         *
+         * @return The outcome.
+         */
+        e_attach_status attach( std::chrono::milliseconds timeout = c_target::forever ) noexcept;
+
+        /**
+         * @brief Resolves FFlags ahead of apply() so the first apply only has to write.
+         *
+         * @param entries The entries whose FFlags to resolve. Their values are ignored.
+         * @param statuses Receives one status per entry, ok or missing.
+         *
+         * @return ok, or why the call did not go through.
+         */
+        e_call_status resolve( std::span< const entry_t > entries, std::vector< e_apply_status > &statuses ) noexcept;
+
+        /**
+         * @brief Writes a batch of values. FFlags resolved by earlier calls are not looked up again.
+         *
+         * @param entries The entries to apply.
+         * @param statuses Receives one status per entry.
+         *
+         * @return ok, or why the call did not go through.
+         */
+        e_call_status apply( std::span< const entry_t > entries, std::vector< e_apply_status > &statuses ) noexcept;
+
+        /**
+         * @brief Reads the current values of a batch of FFlags.
+         *
+         * @param entries The entries whose FFlags to read. Their values are ignored.
+         * @param values Receives one value per entry, formatted the way fflags.json writes it, or std::nullopt if it
+         *               could not be read.
+         *
+         * @return ok, or why the call did not go through.
+         */
+        e_call_status snapshot( std::span< const entry_t > entries, std::vector< std::optional< std::string > > &values ) noexcept;
+
+        /**
+         * @brief Releases the attached client. The offset caches are kept, so attaching to the same build again is warm.
+         */
+        void detach( ) noexcept;
+
+        /**
+         * @brief Checks whether the session is attached to a client with a located FFlag table.
+         *
+         * @return True if attached, false otherwise.
+         */
+        [[nodiscard]] bool attached( ) const noexcept
+        {
+            return m_fflags and m_fflags->singleton( );
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
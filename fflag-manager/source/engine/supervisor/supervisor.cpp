@@ -0,0 +1,171 @@
+#include "supervisor.hpp"
+
+// local->misc
+#include "constants.hpp"
+#include "logger/logger.hpp"
+
+namespace odessa::engine
+{
+    std::unique_ptr< c_memory > c_supervisor::find( std::chrono::milliseconds timeout ) noexcept
+    {
+        const auto started = std::chrono::steady_clock::now( );
+
+        auto memory = std::make_unique< c_memory >( constants::client_name, timeout );
+        if ( !memory->target( ).valid( ) )
+            return nullptr;
+
+        m_detected = std::chrono::steady_clock::now( );
+
+        const auto waited    = std::chrono::duration_cast< std::chrono::milliseconds >( m_detected - started );
+        const auto remaining = timeout == c_target::forever ? timeout : std::max( timeout - waited, std::chrono::milliseconds::zero( ) );
+
+        if ( !memory->target( ).wait( remaining ) )
+            return nullptr;
+
+        return memory;
+    }
+
+    std::unique_ptr< c_fflags > c_supervisor::locate( c_memory &memory, const scan_config_t &scan ) noexcept
+    {
+        memory.cache( );
+        memory.throttle( scan );
+
+        ++m_stats.sessions;
+
+        m_stats.reused    = 0;
+        m_stats.looked_up = 0;
+
+        const auto build = memory.build( );
+
+        g_logger->debug( "attached to pid {}, build {:#x} ({:#x} bytes)", memory.pid( ), build.timestamp, build.size );
+
+        if ( build.valid( ) and build == m_build )
+            ++m_stats.warm;
+        else
+        {
+            if ( m_build.valid( ) )
+                g_logger->summary( "client build changed, dropping cached offsets" );
+
+            m_build     = build;
+            m_singleton = 0;
+            m_offsets.clear( );
+        }
+
+        auto fflags = std::make_unique< c_fflags >( memory, m_singleton );
+        m_singleton = fflags->offset( );
+
+        return fflags;
+    }
+
+    void c_supervisor::attach( std::unique_ptr< c_memory > memory, const scan_config_t &scan ) noexcept
+    {
+        auto fflags = locate( *memory, scan );
+
+        attach( std::move( memory ), std::move( fflags ) );
+    }
+
+    std::vector< c_remote_fflag > c_supervisor::resolve( std::span< const std::string > names ) noexcept
+    {
+        const auto mod = g_memory->module( constants::client_name );
+        if ( !mod or !g_fflags->singleton( ) )
+            return g_fflags->find( names );
+
+        // cached GetSets skip the walk, but the client still has to be as far along as a cold lookup would wait for
+        static_cast< void >( g_fflags->table( ) );
+
+        std::vector< c_remote_fflag > results;
+        results.reserve( names.size( ) );
+
+        std::vector< std::size_t >    cached;
+        std::vector< read_request_t > requests;
+
+        for ( std::size_t idx = 0; idx < names.size( ); ++idx )
+        {
+            results.emplace_back( 0 );
+
+            if ( const auto it = m_offsets.find( names[ idx ] ); it != m_offsets.end( ) )
+            {
+                cached.push_back( idx );
+                requests.push_back( { .address = mod->base + it->second.get_set, .size = sizeof( std::uint64_t ) } );
+            }
+        }
+
+        std::vector< std::uint64_t > vftables( requests.size( ), 0 );
+
+        for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+            requests[ idx ].buffer = &vftables[ idx ];
+
+        g_memory->read_batch( requests );
+
+        for ( std::size_t idx = 0; idx < cached.size( ); ++idx )
+        {
+            const auto &offset = m_offsets[ names[ cached[ idx ] ] ];
+
+            if ( requests[ idx ].result != sizeof( std::uint64_t ) or vftables[ idx ] != mod->base + offset.vftable )
+                continue;
+
+            results[ cached[ idx ] ] = c_remote_fflag { requests[ idx ].address };
+            ++m_stats.reused;
+        }
+
+        std::vector< std::size_t > missing;
+        std::vector< std::string > missing_names;
+
+        for ( std::size_t idx = 0; idx < results.size( ); ++idx )
+        {
+            if ( results[ idx ] )
+                continue;
+
+            missing.push_back( idx );
+            missing_names.push_back( names[ idx ] );
+        }
+
+        if ( missing.empty( ) )
+            return results;
+
+        auto found = g_fflags->find( missing_names );
+
+        for ( std::size_t idx = 0; idx < missing.size( ); ++idx )
+        {
+            auto &fflag = found[ idx ];
+            if ( !fflag )
+                continue;
+
+            ++m_stats.looked_up;
+
+            const auto get_set = fflag.address( ) - mod->base;
+            const auto vftable = reinterpret_cast< std::uint64_t >( fflag->vftable ) - mod->base;
+
+            // heap allocated GetSets move between instances, only image-relative ones can be reused
+            if ( get_set < mod->size and vftable < mod->size )
+                m_offsets[ missing_names[ idx ] ] = { .get_set = get_set, .vftable = vftable };
+
+            results[ missing[ idx ] ] = std::move( fflag );
+        }
+
+        return results;
+    }
+
+    void c_supervisor::applied( ) noexcept
+    {
+        const auto latency = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now( ) - m_detected ).count( );
+
+        m_stats.last  = latency;
+        m_stats.best  = m_stats.sessions == 1 ? latency : std::min( m_stats.best, latency );
+        m_stats.worst = std::max( m_stats.worst, latency );
+        m_stats.total += latency;
+    }
+
+    void c_supervisor::detach( ) noexcept
+    {
+        g_memory->target( ).join( );
+
+        release( );
+    }
+
+    void c_supervisor::release( ) noexcept
+    {
+        g_fflags.reset( );
+        g_memory.reset( );
+    }
+} // namespace odessa::engine
\ No newline at end of file
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->engine
+#include "fflags/fflags.hpp"
+
+namespace odessa::engine
+{
+    struct supervisor_stats_t
+    {
+        std::uint64_t sessions { 0 };  ///< Client instances attached to
+        std::uint64_t warm { 0 };      ///< Sessions that reused the caches of a previous instance of the same build
+        std::uint64_t reused { 0 };    ///< FFlags resolved from the offset cache in the last session
+        std::uint64_t looked_up { 0 }; ///< FFlags resolved by walking the hash table in the last session
+
+        double last { 0.0 };  ///< Restart-to-applied latency of the last session in milliseconds
+        double best { 0.0 };  ///< Lowest restart-to-applied latency in milliseconds
+        double worst { 0.0 }; ///< Highest restart-to-applied latency in milliseconds
+        double total { 0.0 }; ///< Sum of all restart-to-applied latencies in milliseconds
+
+        /**
+         * @brief Returns the mean restart-to-applied latency.
+         *
+         * @return The average latency in milliseconds.
+         */
+        [[nodiscard]] double average( ) const noexcept
+        {
+            return sessions ? total / static_cast< double >( sessions ) : 0.0;
+        }
+    };
+
+    class c_supervisor
+    {
+        struct offset_t
+        {
+            std::uint64_t get_set { 0 }; ///< Offset of the GetSet from the module base
+            std::uint64_t vftable { 0 }; ///< Offset of the GetSet's vftable from the module base, used to validate the entry
+        };
+
+        build_t       m_build { };     ///< Build the caches below belong to
+        std::uint64_t m_singleton { 0 }; ///< Offset of the singleton pointer from the module base
+
+        std::unordered_map< std::string, offset_t > m_offsets { }; ///< GetSets that live in the module image, keyed by FFlag name
+
+        supervisor_stats_t                    m_stats { };    ///< Counters reported by stats()
+        std::chrono::steady_clock::time_point m_detected { }; ///< When the current instance was found
+
+      public:
+        /**
+         * @brief Waits for the next client instance to run and create its window. Does not touch g_memory.
+         *
+         * @param timeout How long to wait at most.
+         *
+         * @return The instance's memory, or nullptr if it was not ready in time.
+         */
+        std::unique_ptr< c_memory > find( std::chrono::milliseconds timeout = c_target::forever ) noexcept;
+
+        /**
+         * @brief Locates the FFlag table of a client instance returned by find(). Does not touch g_memory.
+         *
+         * If the client build is unchanged since the previous session, the singleton offset and the FFlag offsets are
+         * kept, otherwise they are dropped. Locating may wait for another instance scanning the same build, then scan.
+         *
+         * @param memory The instance's memory.
+         * @param scan How the client module is scanned if the singleton has to be found again.
+         *
+         * @return The instance's FFlag manager.
+         */
+        std::unique_ptr< c_fflags > locate( c_memory &memory, const scan_config_t &scan = { } ) noexcept;
+
+        /**
+         * @brief Installs a client instance located by locate() as g_memory and g_fflags.
+         *
+         * @param memory The instance's memory.
+         * @param fflags The instance's FFlag manager.
+         */
+        void attach( std::unique_ptr< c_memory > memory, std::unique_ptr< c_fflags > fflags ) noexcept
+        {
+            g_memory = std::move( memory );
+            g_fflags = std::move( fflags );
+        }
+
+        /**
+         * @brief Locates the FFlag table of a client instance returned by find() and installs it.
+         *
+         * @param memory The instance's memory.
+         * @param scan How the client module is scanned if the singleton has to be found again.
+         */
+        void attach( std::unique_ptr< c_memory > memory, const scan_config_t &scan = { } ) noexcept;
+
+        /**
+         * @brief Waits for the next client instance and attaches to it.
+         *
+         * @param scan How the client module is scanned if the singleton has to be found again.
+         */
+        void attach( const scan_config_t &scan = { } ) noexcept
+        {
+            attach( find( ), scan );
+        }
+
+        /**
+         * @brief Resolves FFlags for the attached instance.
+         *
+         * Cached offsets are rebased and validated against their vftable in a single batched read, only the
+         * remaining names are looked up in the hash table. GetSets found inside the module image are cached
+         * for the next session.
+         *
+         * @param names The names of the FFlags to find (case-sensitive).
+         *
+         * @return One proxy per name, in the same order. Missing flags yield an invalid proxy.
+         */
+        std::vector< c_remote_fflag > resolve( std::span< const std::string > names ) noexcept;
+
+        /**
+         * @brief Records that the current session's FFlags have been applied.
+         */
+        void applied( ) noexcept;
+
+        /**
+         * @brief Blocks until the attached instance exits, then releases it.
+         */
+        void detach( ) noexcept;
+
+        /**
+         * @brief Releases g_fflags and g_memory right away. The caches are kept for the next attach().
+         */
+        void release( ) noexcept;
+
+        /**
+         * @brief Returns the supervisor counters.
+         *
+         * @return The counters.
+         */
+        [[nodiscard]] const supervisor_stats_t &stats( ) const noexcept
+        {
+            return m_stats;
+        }
+    };
+} // namespace odessa::engine
\ No newline at end of file
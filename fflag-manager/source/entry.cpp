@@ -2,18 +2,138 @@
 
 // local->misc
 #include "constants.hpp"
+#include "logger/logger.hpp"
 #include "memory/memory.hpp"
+#include "targets/dump/dump.hpp"
+#include "targets/image/image.hpp"
+#include "targets/trace/trace.hpp"
 
 // local->engine
 #include "fflags/fflags.hpp"
 #include "engine/engine.hpp"
 
-std::int32_t main( )
+std::int32_t main( std::int32_t argc, char **argv )
 {
-    odessa::g_memory         = std::make_unique< odessa::c_memory >( odessa::constants::client_name );
+    std::vector< std::string >     arguments;
+    odessa::log_config_t           log_config;
+    odessa::engine::apply_config_t apply_config;
+    std::string                    record_path;
+    bool                           realtime { false };
+
+    // logging: --quiet (summary only) | --verbose | --log <records.jsonl>
+    // tracing: --record <session.trace> | --realtime (replay at recorded speed)
+    // applying: --watch <seconds> (how long to wait for flags registered after startup, 0 to skip) | --atomic (all or nothing)
+    // scanning: --low-impact <MiB/s> (pace the pattern scan and read resident pages first, 0 to only yield)
+    for ( std::int32_t idx = 1; idx < argc; ++idx )
+    {
+        const std::string argument = argv[ idx ];
+
+        if ( argument == "--quiet" )
+            log_config.summary_only = true;
+        else if ( argument == "--verbose" )
+            log_config.level = odessa::e_log_level::debug;
+        else if ( argument == "--log" and idx + 1 < argc )
+            log_config.json_path = argv[ ++idx ];
+        else if ( argument == "--record" and idx + 1 < argc )
+            record_path = argv[ ++idx ];
+        else if ( argument == "--realtime" )
+            realtime = true;
+        else if ( argument == "--watch" and idx + 1 < argc )
+            apply_config.watch = std::chrono::seconds( std::strtoul( argv[ ++idx ], nullptr, 10 ) );
+        else if ( argument == "--atomic" )
+            apply_config.atomic = true;
+        else if ( argument == "--low-impact" and idx + 1 < argc )
+            apply_config.scan = { .low_impact = true, .budget = std::strtoull( argv[ ++idx ], nullptr, 10 ) << 20 };
+        else
+            arguments.push_back( argument );
+    }
+
+    odessa::g_logger = std::make_unique< odessa::c_logger >( log_config );
+
+    // offline: odessa --image <RobloxPlayerBeta.exe> | --dump <client.dmp>
+    if ( arguments.size( ) == 2 and ( arguments[ 0 ] == "--image" or arguments[ 0 ] == "--dump" ) )
+    {
+        std::unique_ptr< odessa::c_target > target;
+
+        if ( arguments[ 0 ] == "--image" )
+            target = std::make_unique< odessa::c_image_target >( arguments[ 1 ] );
+        else
+            target = std::make_unique< odessa::c_dump_target >( arguments[ 1 ] );
+
+        if ( !target->valid( ) )
+        {
+            odessa::g_logger->error( "failed to map {}", arguments[ 1 ] );
+            return EXIT_FAILURE;
+        }
+
+        odessa::g_memory = std::make_unique< odessa::c_memory >( std::move( target ) );
+
+        return odessa::engine::seed( ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // replay: odessa --replay <session.trace>
+    if ( arguments.size( ) == 2 and arguments[ 0 ] == "--replay" )
+    {
+        auto replay = std::make_unique< odessa::c_replay_target >( arguments[ 1 ], realtime );
+
+        if ( !replay->valid( ) )
+        {
+            odessa::g_logger->error( "failed to load trace {}", arguments[ 1 ] );
+            return EXIT_FAILURE;
+        }
+
+        const auto  offset = replay->note( "singleton" ).value_or( 0 );
+        const auto &trace  = *replay;
+
+        odessa::g_memory = std::make_unique< odessa::c_memory >( std::move( replay ) );
+        odessa::g_memory->cache( );
+
+        odessa::engine::g_fflags = std::make_unique< odessa::engine::c_fflags >( offset );
+
+        // the trace's addresses belong to a client that may not even exist anymore, keep its journal in memory
+        apply_config.journal.clear( );
+
+        odessa::engine::setup( apply_config );
+
+        const auto stats = trace.stats( );
+        odessa::g_logger->summary( "replayed {} calls, {} diverged from the trace", stats.matched + stats.diverged, stats.diverged );
+
+        return EXIT_SUCCESS;
+    }
+
+    // resident: odessa --supervise
+    if ( arguments.size( ) == 1 and arguments[ 0 ] == "--supervise" )
+    {
+        odessa::engine::supervise( apply_config );
+        return EXIT_SUCCESS;
+    }
+
+    odessa::g_memory = std::make_unique< odessa::c_memory >( odessa::constants::client_name );
+
+    if ( !record_path.empty( ) )
+    {
+        odessa::g_memory->record( record_path );
+
+        if ( !odessa::g_memory->target( ).valid( ) )
+        {
+            odessa::g_logger->error( "failed to create trace {}", record_path );
+            return EXIT_FAILURE;
+        }
+    }
+
+    odessa::g_memory->cache( );
+    odessa::g_memory->throttle( apply_config.scan );
+
+    // undo: odessa --restore
+    if ( arguments.size( ) == 1 and arguments[ 0 ] == "--restore" )
+        return odessa::engine::restore( apply_config.journal ) ? EXIT_SUCCESS : EXIT_FAILURE;
+
     odessa::engine::g_fflags = std::make_unique< odessa::engine::c_fflags >( );
 
-    odessa::engine::setup( );
+    // lets a replay skip address.json, which is not part of the trace
+    odessa::g_memory->target( ).note( "singleton", odessa::engine::g_fflags->offset( ) );
+
+    odessa::engine::setup( apply_config );
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
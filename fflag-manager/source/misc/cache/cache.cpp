@@ -0,0 +1,180 @@
+#include "cache.hpp"
+
+namespace odessa
+{
+    c_page_cache::c_page_cache( const cache_config_t &config ) noexcept : m_config( config ), m_window( config.read_ahead_min )
+    {
+        m_config.capacity       = std::max< std::size_t >( m_config.capacity, 1 );
+        m_config.read_ahead_min = std::max< std::size_t >( m_config.read_ahead_min, 1 );
+        m_config.read_ahead_max = std::max( m_config.read_ahead_max, m_config.read_ahead_min );
+        m_window                = m_config.read_ahead_min;
+    }
+
+    c_page_cache::page_t *c_page_cache::lookup( std::uint64_t page ) noexcept
+    {
+        const auto it = m_pages.find( page );
+        if ( it == m_pages.end( ) or it->second.epoch != m_epoch )
+            return nullptr;
+
+        m_lru.splice( m_lru.begin( ), m_lru, it->second.lru );
+        return &it->second;
+    }
+
+    c_page_cache::page_t *c_page_cache::insert( std::uint64_t page, const std::uint8_t *bytes ) noexcept
+    {
+        auto [ it, inserted ] = m_pages.try_emplace( page );
+
+        if ( inserted )
+        {
+            m_lru.push_front( page );
+            it->second.lru = m_lru.begin( );
+        }
+        else
+            m_lru.splice( m_lru.begin( ), m_lru, it->second.lru );
+
+        std::memcpy( it->second.bytes.data( ), bytes, page_size );
+        it->second.epoch = m_epoch;
+
+        while ( m_pages.size( ) > m_config.capacity )
+        {
+            m_pages.erase( m_lru.back( ) );
+            m_lru.pop_back( );
+        }
+
+        return &it->second;
+    }
+
+    c_page_cache::page_t *c_page_cache::fill( const c_target &target, std::uint64_t page ) noexcept
+    {
+        // grow the window while misses keep landing right after the previous read-ahead, shrink it otherwise
+        if ( page == m_sequential )
+            m_window = std::min( m_window * 2, m_config.read_ahead_max );
+        else
+            m_window = m_config.read_ahead_min;
+
+        std::vector< std::uint8_t > buffer( m_window * page_size );
+
+        ++m_stats.syscalls;
+        auto bytes_read = target.read( page, buffer.data( ), buffer.size( ) );
+
+        // the window may run into an unreadable page, retry with just the page that was asked for
+        if ( bytes_read < page_size and m_window > 1 )
+        {
+            m_window = m_config.read_ahead_min;
+
+            ++m_stats.syscalls;
+            bytes_read = target.read( page, buffer.data( ), page_size );
+        }
+
+        if ( bytes_read < page_size )
+            return nullptr;
+
+        const auto pages = std::min< std::size_t >( bytes_read / page_size, m_config.capacity );
+
+        // insert back to front so the requested page ends up most recently used
+        for ( auto idx = pages; idx-- > 1; )
+        {
+            if ( !lookup( page + idx * page_size ) )
+                insert( page + idx * page_size, buffer.data( ) + idx * page_size );
+        }
+
+        m_sequential = page + pages * page_size;
+
+        return insert( page, buffer.data( ) );
+    }
+
+    std::size_t c_page_cache::read( const c_target &target, std::uint64_t address, void *buffer, std::size_t size ) noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        ++m_stats.requests;
+
+        if ( size > m_config.threshold )
+        {
+            ++m_stats.bypassed;
+            ++m_stats.syscalls;
+            return target.read( address, buffer, size );
+        }
+
+        auto       *output = static_cast< std::uint8_t * >( buffer );
+        std::size_t total { 0 };
+        bool        missed { false };
+
+        while ( total < size )
+        {
+            const auto current = address + total;
+            const auto page    = current & ~( page_size - 1 );
+            const auto offset  = current - page;
+            const auto chunk   = std::min< std::uint64_t >( size - total, page_size - offset );
+
+            auto *entry = lookup( page );
+            if ( !entry )
+            {
+                missed = true;
+                entry  = fill( target, page );
+            }
+
+            // not page-readable (guard pages, partial regions), let the target decide what it can return
+            if ( !entry )
+            {
+                ++m_stats.syscalls;
+                total += target.read( current, output + total, size - total );
+                break;
+            }
+
+            std::memcpy( output + total, entry->bytes.data( ) + offset, chunk );
+            total += chunk;
+        }
+
+        if ( missed )
+            ++m_stats.misses;
+        else
+            ++m_stats.hits;
+
+        return total;
+    }
+
+    void c_page_cache::update( std::uint64_t address, const void *buffer, std::size_t size, bool written ) noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        const auto *input = static_cast< const std::uint8_t * >( buffer );
+        std::size_t total { 0 };
+
+        while ( total < size )
+        {
+            const auto current = address + total;
+            const auto page    = current & ~( page_size - 1 );
+            const auto offset  = current - page;
+            const auto chunk   = std::min< std::uint64_t >( size - total, page_size - offset );
+
+            if ( const auto it = m_pages.find( page ); it != m_pages.end( ) )
+            {
+                if ( written )
+                    std::memcpy( it->second.bytes.data( ) + offset, input + total, chunk );
+                else
+                {
+                    m_lru.erase( it->second.lru );
+                    m_pages.erase( it );
+                }
+            }
+
+            total += chunk;
+        }
+    }
+
+    void c_page_cache::invalidate( ) noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        ++m_epoch;
+        m_sequential = 0;
+        m_window     = m_config.read_ahead_min;
+    }
+
+    cache_stats_t c_page_cache::stats( ) noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+        return m_stats;
+    }
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "targets/target.hpp"
+
+namespace odessa
+{
+    struct cache_config_t
+    {
+        std::size_t capacity { 256 };       ///< Maximum number of resident pages
+        std::size_t threshold { 0x1000 };   ///< Reads larger than this bypass the cache
+        std::size_t read_ahead_min { 1 };   ///< Pages fetched on an isolated miss
+        std::size_t read_ahead_max { 16 };  ///< Pages the read-ahead window may grow to on consecutive misses
+    };
+
+    struct cache_stats_t
+    {
+        std::uint64_t requests { 0 }; ///< Reads served through the cache
+        std::uint64_t hits { 0 };     ///< Reads served entirely from resident pages
+        std::uint64_t misses { 0 };   ///< Reads that had to fetch at least one page
+        std::uint64_t bypassed { 0 }; ///< Reads forwarded to the target because they were too large
+        std::uint64_t syscalls { 0 }; ///< Reads actually issued to the target
+
+        /**
+         * @brief Returns the fraction of cacheable reads served without touching the target.
+         *
+         * @return The hit rate in the range [0, 1].
+         */
+        [[nodiscard]] double hit_rate( ) const noexcept
+        {
+            const auto cacheable = hits + misses;
+            return cacheable ? static_cast< double >( hits ) / static_cast< double >( cacheable ) : 0.0;
+        }
+
+        /**
+         * @brief Returns the number of target reads avoided compared to issuing one per request.
+         *
+         * @return The number of syscalls saved.
+         */
+        [[nodiscard]] std::uint64_t saved( ) const noexcept
+        {
+            return requests > syscalls ? requests - syscalls : 0;
+        }
+    };
+
+    class c_page_cache
+    {
+        static constexpr std::uint64_t page_size { 0x1000 }; ///< Granularity of the cache
+
+        struct page_t
+        {
+            std::array< std::uint8_t, page_size > bytes { }; ///< Local copy of the page
+            std::uint64_t                         epoch { 0 }; ///< Epoch the copy was taken in
+            std::list< std::uint64_t >::iterator  lru { };     ///< Position in the recency list
+        };
+
+        cache_config_t m_config { }; ///< Cache configuration
+
+        std::mutex                              m_mutex { }; ///< Guards every member below
+        std::unordered_map< std::uint64_t, page_t > m_pages { }; ///< Resident pages keyed by page address
+        std::list< std::uint64_t >              m_lru { };   ///< Page addresses, most recently used first
+
+        std::uint64_t m_epoch { 0 };        ///< Current epoch, pages from older epochs are stale
+        std::uint64_t m_sequential { 0 };   ///< Page right after the last read-ahead, used to detect sequential misses
+        std::size_t   m_window { 1 };       ///< Current read-ahead window in pages
+
+        cache_stats_t m_stats { }; ///< Counters reported by stats()
+
+        /**
+         * @brief Returns a resident, current page and marks it as most recently used.
+         *
+         * @param page The page address.
+         *
+         * @return A pointer to the page, or nullptr if it is missing or stale.
+         */
+        page_t *lookup( std::uint64_t page ) noexcept;
+
+        /**
+         * @brief Fetches a page, and the read-ahead window following it, from the target.
+         *
+         * @param target The backend to read from.
+         * @param page The page address.
+         *
+         * @return A pointer to the freshly cached page, or nullptr if it is not readable.
+         */
+        page_t *fill( const c_target &target, std::uint64_t page ) noexcept;
+
+        /**
+         * @brief Inserts or refreshes a page and evicts the least recently used ones over capacity.
+         *
+         * @param page The page address.
+         * @param bytes The contents of the page.
+         *
+         * @return A pointer to the cached page.
+         */
+        page_t *insert( std::uint64_t page, const std::uint8_t *bytes ) noexcept;
+
+      public:
+        /**
+         * @brief Creates an empty page cache.
+         *
+         * @param config The cache configuration.
+         */
+        c_page_cache( const cache_config_t &config ) noexcept;
+
+        /**
+         * @brief Reads through the cache, fetching missing pages from the target.
+         *
+         * @param target The backend to read from on a miss.
+         * @param address The address to read from.
+         * @param buffer The destination buffer.
+         * @param size The number of bytes to read.
+         *
+         * @return The number of bytes read.
+         */
+        std::size_t read( const c_target &target, std::uint64_t address, void *buffer, std::size_t size ) noexcept;
+
+        /**
+         * @brief Keeps resident pages coherent with a write issued to the target.
+         *
+         * @param address The address that was written.
+         * @param buffer The bytes that were written.
+         * @param size The number of bytes written.
+         * @param written Whether the write succeeded. Failed writes drop the affected pages.
+         */
+        void update( std::uint64_t address, const void *buffer, std::size_t size, bool written ) noexcept;
+
+        /**
+         * @brief Starts a new epoch, making every resident page stale.
+         *
+         * Used when the target may have changed its own memory, e.g. between passes of a resident watcher.
+         */
+        void invalidate( ) noexcept;
+
+        /**
+         * @brief Returns a snapshot of the cache counters.
+         *
+         * @return The counters.
+         */
+        [[nodiscard]] cache_stats_t stats( ) noexcept;
+    };
+} // namespace odessa
\ No newline at end of file
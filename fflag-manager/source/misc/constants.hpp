@@ -2,10 +2,15 @@
 
 #include "native.hpp"
 
+// local->misc
+#include "signature/signature.hpp"
+
 namespace odessa::constants
 {
     static const std::string client_name = "RobloxPlayerBeta.exe"; ///< Name of the target process.
 
-    static const std::vector< std::uint8_t > pattern
-        = { 0x48, 0x83, 0xec, 0x38, 0x48, 0x8b, 0x0d, 0xcc, 0xcc, 0xcc, 0xcc, 0x4c, 0x8d, 0x05 }; ///< Pattern to scan for.
+    using namespace literals;
+
+    static constexpr auto pattern
+        = "48 83 EC 38 48 8B 0D ?? ?? ?? ?? 4C 8D 05"_sig.with_relative( 4, 3, 7 ); ///< Pattern to scan for, resolves `mov rcx, [rip+x]`.
 } // namespace odessa::constants
\ No newline at end of file
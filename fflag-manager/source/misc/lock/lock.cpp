@@ -0,0 +1,24 @@
+#include "lock.hpp"
+
+namespace odessa
+{
+    c_named_lock::c_named_lock( const std::string &name, std::chrono::milliseconds timeout ) noexcept
+    {
+        m_mutex = CreateMutexA( nullptr, FALSE, ( "Local\\" + name ).c_str( ) );
+        if ( !m_mutex )
+            return;
+
+        // an abandoned mutex is still handed over, its holder died and whatever it guarded is validated by the caller
+        const auto result = WaitForSingleObject( m_mutex, static_cast< DWORD >( timeout.count( ) ) );
+        m_held            = result == WAIT_OBJECT_0 or result == WAIT_ABANDONED;
+    }
+
+    c_named_lock::~c_named_lock( ) noexcept
+    {
+        if ( m_held )
+            ReleaseMutex( m_mutex );
+
+        if ( m_mutex )
+            CloseHandle( m_mutex );
+    }
+} // namespace odessa
\ No newline at end of file
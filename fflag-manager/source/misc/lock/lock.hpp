@@ -0,0 +1,43 @@
+#pragma once
+
+#include "native.hpp"
+
+namespace odessa
+{
+    class c_named_lock
+    {
+        bool m_held { false }; ///< Whether the lock was acquired
+
+        HANDLE m_mutex { nullptr }; ///< Handle to the named mutex
+
+      public:
+        /**
+         * @brief Acquires a lock shared by every process on the machine that uses the same name.
+         *
+         * Backed by a named mutex, which the system releases if the holder dies, so a crashed instance never blocks
+         * the others.
+         *
+         * @param name The name of the lock.
+         * @param timeout How long to wait for another holder to release it.
+         */
+        c_named_lock( const std::string &name, std::chrono::milliseconds timeout ) noexcept;
+
+        /**
+         * @brief Releases the lock.
+         */
+        ~c_named_lock( ) noexcept;
+
+        c_named_lock( const c_named_lock & )             = delete;
+        c_named_lock &operator=( const c_named_lock & ) = delete;
+
+        /**
+         * @brief Checks whether the lock was acquired before the timeout.
+         *
+         * @return True if the lock is held, false otherwise.
+         */
+        explicit operator bool ( ) const noexcept
+        {
+            return m_held;
+        }
+    };
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "logger.hpp"
+
+// vendor
+#include <nlohmann/json.hpp>
+
+namespace odessa
+{
+    constexpr std::array< const char *, 4 > level_names = { "debug", "info", "warning", "error" };
+
+    c_logger::c_logger( const log_config_t &config ) noexcept : m_config( config )
+    {
+        const auto capacity = std::bit_ceil( std::max< std::size_t >( m_config.capacity, 2 ) );
+
+        m_slots = std::make_unique< slot_t[] >( capacity );
+        m_mask  = capacity - 1;
+
+        for ( std::uint64_t idx = 0; idx < capacity; ++idx )
+            m_slots[ idx ].sequence.store( idx, std::memory_order_relaxed );
+
+        if ( !m_config.json_path.empty( ) )
+        {
+            m_json.open( m_config.json_path, std::ios::app );
+
+            // log() only looks at the path, so a sink that failed to open must not keep records alive
+            if ( !m_json.is_open( ) )
+                m_config.json_path.clear( );
+        }
+
+        m_thread = std::thread( &c_logger::drain, this );
+    }
+
+    c_logger::~c_logger( ) noexcept
+    {
+        m_running.store( false, std::memory_order_release );
+
+        m_signal.fetch_add( 1, std::memory_order_release );
+        m_signal.notify_one( );
+
+        if ( m_thread.joinable( ) )
+            m_thread.join( );
+    }
+
+    void c_logger::push( log_record_t &&record ) noexcept
+    {
+        auto position = m_head.load( std::memory_order_relaxed );
+
+        slot_t *slot { nullptr };
+
+        while ( true )
+        {
+            slot = &m_slots[ position & m_mask ];
+
+            const auto sequence   = slot->sequence.load( std::memory_order_acquire );
+            const auto difference = static_cast< std::int64_t >( sequence ) - static_cast< std::int64_t >( position );
+
+            if ( difference == 0 )
+            {
+                if ( m_head.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+                    break;
+            }
+            else if ( difference < 0 )
+            {
+                // the consumer is a full lap behind, losing a line beats stalling the caller on the console
+                m_dropped.fetch_add( 1, std::memory_order_relaxed );
+                return;
+            }
+            else
+                position = m_head.load( std::memory_order_relaxed );
+        }
+
+        slot->record = std::move( record );
+        slot->sequence.store( position + 1, std::memory_order_release );
+
+        m_signal.fetch_add( 1, std::memory_order_release );
+        m_signal.notify_one( );
+    }
+
+    void c_logger::drain( ) noexcept
+    {
+        std::string console_lines;
+        std::string json_lines;
+
+        while ( true )
+        {
+            const auto signal = m_signal.load( std::memory_order_acquire );
+
+            auto position = m_tail.load( std::memory_order_relaxed );
+
+            console_lines.clear( );
+            json_lines.clear( );
+
+            while ( true )
+            {
+                auto &slot = m_slots[ position & m_mask ];
+
+                if ( slot.sequence.load( std::memory_order_acquire ) != position + 1 )
+                    break;
+
+                const auto record = std::move( slot.record );
+                slot.sequence.store( position + m_mask + 1, std::memory_order_release );
+                ++position;
+
+                if ( console( record.level, record.summary ) )
+                {
+                    console_lines += record.message;
+                    console_lines += '\n';
+                }
+
+                if ( m_json.is_open( ) )
+                {
+                    nlohmann::json line;
+
+                    line[ "time" ]    = record.time;
+                    line[ "level" ]   = level_names[ static_cast< std::size_t >( record.level ) ];
+                    line[ "summary" ] = record.summary;
+                    line[ "message" ] = record.message;
+
+                    // messages carry paths in the ANSI code page, which are not valid UTF-8 and would throw on this thread
+                    json_lines += line.dump( -1, ' ', false, nlohmann::json::error_handler_t::replace );
+                    json_lines += '\n';
+                }
+            }
+
+            if ( !console_lines.empty( ) )
+            {
+                std::fwrite( console_lines.data( ), 1, console_lines.size( ), stdout );
+                std::fflush( stdout );
+            }
+
+            if ( !json_lines.empty( ) )
+            {
+                m_json.write( json_lines.data( ), static_cast< std::streamsize >( json_lines.size( ) ) );
+                m_json.flush( );
+            }
+
+            if ( position != m_tail.load( std::memory_order_relaxed ) )
+            {
+                m_tail.store( position, std::memory_order_release );
+                m_tail.notify_all( );
+                continue;
+            }
+
+            if ( !m_running.load( std::memory_order_acquire ) and position == m_head.load( std::memory_order_acquire ) )
+                break;
+
+            m_signal.wait( signal, std::memory_order_acquire );
+        }
+    }
+
+    void c_logger::flush( ) noexcept
+    {
+        const auto target = m_head.load( std::memory_order_acquire );
+
+        for ( auto tail = m_tail.load( std::memory_order_acquire ); tail < target; tail = m_tail.load( std::memory_order_acquire ) )
+            m_tail.wait( tail, std::memory_order_acquire );
+    }
+} // namespace odessa
\ No newline at end of file
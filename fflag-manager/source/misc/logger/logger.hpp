@@ -0,0 +1,170 @@
+#pragma once
+
+#include "native.hpp"
+
+namespace odessa
+{
+    enum class e_log_level : std::uint8_t
+    {
+        debug   = 0, ///< Diagnostics, hidden unless requested
+        info    = 1, ///< Regular progress, e.g. one line per FFlag
+        warning = 2, ///< Problems that do not stop the run
+        error   = 3  ///< Failures
+    };
+
+    struct log_config_t
+    {
+        e_log_level level { e_log_level::info }; ///< Lowest level written to the console
+        bool        summary_only { false };      ///< Only write summaries, warnings and errors to the console
+        bool        console { true };            ///< Write to the console at all, off when embedded as a library
+        std::string json_path { "" };            ///< File receiving every record as JSON lines, empty to disable
+        std::size_t capacity { 4096 };           ///< Records the ring buffer can hold, rounded up to a power of two
+    };
+
+    struct log_record_t
+    {
+        std::int64_t time { 0 };                  ///< Milliseconds since the Unix epoch, taken by the producer
+        e_log_level  level { e_log_level::info }; ///< Severity of the record
+        bool         summary { false };           ///< Whether the record is part of the run summary
+        std::string  message { "" };              ///< Formatted message
+    };
+
+    class c_logger
+    {
+        struct slot_t
+        {
+            std::atomic< std::uint64_t > sequence { 0 }; ///< Tells producers and the consumer whose turn the slot is
+            log_record_t                 record { };     ///< Record stored in the slot
+        };
+
+        log_config_t m_config { }; ///< Logger configuration
+
+        std::unique_ptr< slot_t[] > m_slots { nullptr }; ///< Ring buffer
+        std::uint64_t               m_mask { 0 };        ///< Slot count - 1
+
+        alignas( 64 ) std::atomic< std::uint64_t > m_head { 0 }; ///< Next position claimed by a producer
+        alignas( 64 ) std::atomic< std::uint64_t > m_tail { 0 }; ///< Next position drained by the consumer
+
+        std::atomic< std::uint64_t > m_signal { 0 };    ///< Bumped on every publish to wake the consumer
+        std::atomic< std::uint64_t > m_dropped { 0 };   ///< Records dropped because the ring buffer was full
+        std::atomic< bool >          m_running { true }; ///< Cleared to stop the consumer once it has drained
+
+        std::ofstream m_json { }; ///< JSON lines sink, only touched by the consumer
+        std::thread   m_thread { }; ///< Consumer draining the ring buffer
+
+        /**
+         * @brief Publishes a record without blocking. Drops it if the ring buffer is full.
+         *
+         * @param record The record to publish.
+         */
+        void push( log_record_t &&record ) noexcept;
+
+        /**
+         * @brief Consumer loop, writes records to the sinks until the logger is destroyed.
+         */
+        void drain( ) noexcept;
+
+        /**
+         * @brief Checks whether a record would reach the console.
+         */
+        [[nodiscard]] bool console( e_log_level level, bool summary ) const noexcept
+        {
+            if ( !m_config.console )
+                return false;
+
+            if ( m_config.summary_only )
+                return summary or level >= e_log_level::warning;
+
+            return level >= m_config.level;
+        }
+
+      public:
+        /**
+         * @brief Creates the logger and starts its consumer thread.
+         *
+         * @param config The logger configuration.
+         */
+        c_logger( const log_config_t &config = { } ) noexcept;
+
+        /**
+         * @brief Drains every pending record and stops the consumer thread.
+         */
+        ~c_logger( ) noexcept;
+
+        /**
+         * @brief Formats and queues a record. Never waits on the sinks.
+         *
+         * Records no sink would accept are discarded before they are formatted.
+         *
+         * @param level The severity of the record.
+         * @param summary Whether the record is part of the run summary.
+         * @param format The format string.
+         * @param args The format arguments.
+         */
+        template < typename... args_t >
+        void log( e_log_level level, bool summary, std::format_string< args_t... > format, args_t &&...args ) noexcept
+        {
+            if ( m_config.json_path.empty( ) and !console( level, summary ) )
+                return;
+
+            const auto time = std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::system_clock::now( ).time_since_epoch( ) );
+
+            push( {
+                .time    = time.count( ),
+                .level   = level,
+                .summary = summary,
+                .message = std::format( format, std::forward< args_t >( args )... ),
+            } );
+        }
+
+        template < typename... args_t >
+        void debug( std::format_string< args_t... > format, args_t &&...args ) noexcept
+        {
+            log( e_log_level::debug, false, format, std::forward< args_t >( args )... );
+        }
+
+        template < typename... args_t >
+        void info( std::format_string< args_t... > format, args_t &&...args ) noexcept
+        {
+            log( e_log_level::info, false, format, std::forward< args_t >( args )... );
+        }
+
+        template < typename... args_t >
+        void warning( std::format_string< args_t... > format, args_t &&...args ) noexcept
+        {
+            log( e_log_level::warning, false, format, std::forward< args_t >( args )... );
+        }
+
+        template < typename... args_t >
+        void error( std::format_string< args_t... > format, args_t &&...args ) noexcept
+        {
+            log( e_log_level::error, false, format, std::forward< args_t >( args )... );
+        }
+
+        /**
+         * @brief Queues an info record that is kept in summary-only mode.
+         */
+        template < typename... args_t >
+        void summary( std::format_string< args_t... > format, args_t &&...args ) noexcept
+        {
+            log( e_log_level::info, true, format, std::forward< args_t >( args )... );
+        }
+
+        /**
+         * @brief Blocks until every record queued so far has been written, e.g. before prompting the user.
+         */
+        void flush( ) noexcept;
+
+        /**
+         * @brief Returns the number of records dropped because the ring buffer was full.
+         *
+         * @return The number of dropped records.
+         */
+        [[nodiscard]] std::uint64_t dropped( ) const noexcept
+        {
+            return m_dropped.load( std::memory_order_relaxed );
+        }
+    };
+
+    inline auto g_logger { std::unique_ptr< c_logger > {} };
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "mapping.hpp"
+
+namespace odessa
+{
+    c_mapping::c_mapping( const std::string &path ) noexcept
+    {
+        m_file = CreateFileA( path.c_str( ), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( m_file == INVALID_HANDLE_VALUE )
+            return;
+
+        LARGE_INTEGER size { };
+        if ( !GetFileSizeEx( m_file, &size ) or size.QuadPart == 0 )
+            return;
+
+        m_mapping = CreateFileMappingA( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( !m_mapping )
+            return;
+
+        m_data = static_cast< const std::uint8_t * >( MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+        if ( m_data )
+            m_size = static_cast< std::size_t >( size.QuadPart );
+    }
+
+    c_mapping::~c_mapping( ) noexcept
+    {
+        if ( m_data )
+            UnmapViewOfFile( m_data );
+
+        if ( m_mapping )
+            CloseHandle( m_mapping );
+
+        if ( m_file != INVALID_HANDLE_VALUE )
+            CloseHandle( m_file );
+    }
+} // namespace odessa
\ No newline at end of file
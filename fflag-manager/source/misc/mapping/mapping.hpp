@@ -0,0 +1,69 @@
+#pragma once
+
+#include "native.hpp"
+
+namespace odessa
+{
+    class c_mapping
+    {
+        const std::uint8_t *m_data { nullptr }; ///< Start of the read-only view
+        std::size_t         m_size { 0 };       ///< Size of the view in bytes
+
+        HANDLE m_file { INVALID_HANDLE_VALUE }; ///< Handle to the mapped file
+        HANDLE m_mapping { nullptr };           ///< Handle to the file mapping object
+
+      public:
+        /**
+         * @brief Maps a file into memory read-only.
+         *
+         * @param path The path of the file to map.
+         */
+        c_mapping( const std::string &path ) noexcept;
+
+        /**
+         * @brief Unmaps the file and releases any associated resources.
+         */
+        ~c_mapping( ) noexcept;
+
+        c_mapping( const c_mapping & )             = delete;
+        c_mapping &operator=( const c_mapping & ) = delete;
+
+        /**
+         * @brief Returns the mapped bytes.
+         *
+         * @return A span over the whole file, or an empty span if mapping failed.
+         */
+        [[nodiscard]] std::span< const std::uint8_t > bytes( ) const noexcept
+        {
+            return { m_data, m_size };
+        }
+
+        /**
+         * @brief Returns a pointer to a structure inside the mapping, with bounds checking.
+         *
+         * @tparam type_t The type of the structure.
+         * @param offset The file offset of the structure.
+         * @param count The number of consecutive structures that must fit.
+         *
+         * @return A pointer into the mapping, or nullptr if the range is out of bounds.
+         */
+        template < typename type_t >
+        [[nodiscard]] const type_t *at( const std::uint64_t offset, const std::uint64_t count = 1 ) const noexcept
+        {
+            if ( offset > m_size or count > ( m_size - offset ) / sizeof( type_t ) )
+                return nullptr;
+
+            return reinterpret_cast< const type_t * >( m_data + offset );
+        }
+
+        /**
+         * @brief Checks whether the file was mapped successfully.
+         *
+         * @return True if the mapping is valid, false otherwise.
+         */
+        explicit operator bool ( ) const noexcept
+        {
+            return m_data != nullptr;
+        }
+    };
+} // namespace odessa
\ No newline at end of file
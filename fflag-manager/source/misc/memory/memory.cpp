@@ -2,206 +2,425 @@
 
 // local->misc
 #include "constants.hpp"
-
-// standard
-#include <tlhelp32.h>
+#include "targets/image/image.hpp"
+#include "targets/process/process.hpp"
+#include "targets/trace/trace.hpp"
 
 namespace odessa
 {
-    c_memory::c_memory( const std::string &name ) noexcept
+    c_memory::c_memory( const std::string &name, std::chrono::milliseconds timeout ) noexcept :
+        m_target( std::make_unique< c_process_target >( name, timeout ) )
+    {
+    }
+
+    c_memory::c_memory( std::unique_ptr< c_target > target ) noexcept : m_target( std::move( target ) ) { }
+
+    c_memory::~c_memory( ) noexcept = default;
+
+    void c_memory::record( const std::string &path ) noexcept
+    {
+        m_target = std::make_unique< c_recording_target >( std::move( m_target ), path );
+    }
+
+    std::unique_ptr< module_t > c_memory::module( const std::string &name ) const noexcept
+    {
+        return m_target->module( name );
+    }
+
+    build_t c_memory::build( ) const noexcept
+    {
+        const auto mod = module( constants::client_name );
+        if ( !mod )
+            return { };
+
+        const auto dos_lfanew  = read< std::uint32_t >( mod->base + 0x3c );
+        const auto file_header = read< pe_file_header_t >( mod->base + dos_lfanew );
+        if ( file_header.signature != 0x4550 )
+            return { };
+
+        const auto optional_header = read< pe_optional_header_t >( mod->base + dos_lfanew + sizeof( pe_file_header_t ) );
+
+        return { .timestamp = file_header.timestamp, .size = optional_header.image_size };
+    }
+
+    void c_memory::regions( const std::function< bool( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept
     {
-        while ( !m_process )
+        const auto mod = module( constants::client_name );
+        if ( !mod )
+            return;
+
+        const auto start = std::chrono::steady_clock::now( );
+
+        m_scan_stats = { .before = m_target->footprint( ) };
+
+        // offline targets hand out views, there is nothing to protect and nothing to fault in
+        if ( m_scan.low_impact and m_target->view( mod->base, mod->size ).empty( ) )
+            walk_paced( *mod, callback );
+        else
+            walk( *mod, callback );
+
+        m_scan_stats.after        = m_target->footprint( );
+        m_scan_stats.milliseconds = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now( ) - start ).count( );
+    }
+
+    void c_memory::walk( const module_t                                                              &mod,
+                         const std::function< bool( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept
+    {
+        std::uint64_t start = mod.base;
+        std::uint64_t end   = mod.base + mod.size;
+
+        while ( start < end )
         {
-            const auto snapshot = CreateToolhelp32Snapshot( TH32CS_SNAPPROCESS, 0 );
-            if ( snapshot == INVALID_HANDLE_VALUE )
-            {
-                Sleep( 500 );
-                continue;
-            }
+            const auto region = m_target->query( start );
+            if ( !region )
+                return;
 
-            PROCESSENTRY32 proc { .dwSize = sizeof( PROCESSENTRY32 ) };
+            const auto region_end = std::min( region->base + region->size, end );
 
-            if ( Process32First( snapshot, &proc ) )
+            if ( region->readable and region_end > start )
             {
-                do
+                const auto region_size = region_end - start;
+
+                if ( const auto view = m_target->view( start, region_size ); view.size( ) == region_size )
                 {
-                    if ( name == proc.szExeFile )
-                    {
-                        m_pid     = static_cast< std::int32_t >( proc.th32ProcessID );
-                        m_process = OpenProcess( PROCESS_ALL_ACCESS, FALSE, proc.th32ProcessID );
-                        break;
-                    }
-                } while ( Process32Next( snapshot, &proc ) );
-            }
+                    m_scan_stats.bytes += view.size( );
 
-            CloseHandle( snapshot );
+                    if ( !callback( start, view ) )
+                        return;
+                }
+                else if ( const auto buffer = read( start, region_size ); !buffer.empty( ) )
+                {
+                    m_scan_stats.bytes += buffer.size( );
+
+                    if ( !callback( start, buffer ) )
+                        return;
+                }
+            }
 
-            if ( !m_process )
-                Sleep( 500 );
+            start = std::max( region_end, start + 1 );
         }
     }
 
-    c_memory::~c_memory( ) noexcept
+    void c_memory::walk_paced( const module_t                                                              &mod,
+                               const std::function< bool( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept
     {
-        if ( m_process )
+        struct run_t
         {
-            CloseHandle( m_process );
-            m_process = nullptr;
-        }
+            std::uint64_t base { 0 }; ///< Start of the run
+            std::uint64_t end { 0 };  ///< End of the run
+            std::uint64_t low { 0 };  ///< Start of the region containing the run
+            std::uint64_t high { 0 }; ///< End of the region containing the run
+        };
 
-        m_pid = 0;
-    }
+        std::vector< run_t > resident;
+        std::vector< run_t > deferred;
 
-    std::unique_ptr< module_t > c_memory::module( const std::string &name ) const noexcept
-    {
-        if ( !m_process or m_pid == 0 )
-            return nullptr;
+        for ( std::uint64_t start = mod.base, end = mod.base + mod.size; start < end; )
+        {
+            const auto region = m_target->query( start );
+            if ( !region )
+                break;
 
-        const auto snapshot = CreateToolhelp32Snapshot( TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, m_pid );
-        if ( snapshot == INVALID_HANDLE_VALUE )
-            return nullptr;
+            const auto region_end = std::min( region->base + region->size, end );
 
-        MODULEENTRY32 mod { .dwSize = sizeof( MODULEENTRY32 ) };
+            if ( region->readable and region_end > start )
+            {
+                const auto pages   = m_target->residency( start, region_end - start );
+                const auto present = [ & ]( std::uint64_t address )
+                {
+                    const auto page = ( address - start ) / c_target::page_size;
+                    return page >= pages.size( ) or pages[ page ];
+                };
+
+                // split the region into runs of pages that are all resident or all paged out
+                for ( std::uint64_t run = start; run < region_end; )
+                {
+                    const bool state   = present( run );
+                    auto       run_end = run;
 
-        std::unique_ptr< module_t > result;
+                    while ( run_end < region_end and present( run_end ) == state )
+                        run_end = std::min( region_end, ( run_end / c_target::page_size + 1 ) * c_target::page_size );
 
-        if ( Module32First( snapshot, &mod ) )
+                    ( state ? resident : deferred ).push_back( { .base = run, .end = run_end, .low = start, .high = region_end } );
+
+                    if ( !state )
+                        m_scan_stats.deferred += run_end - run;
+
+                    run = run_end;
+                }
+            }
+
+            start = std::max( region_end, start + 1 );
+        }
+
+        const auto    began = std::chrono::steady_clock::now( );
+        std::uint64_t paced { 0 };
+
+        const auto read_paced = [ & ]( std::uint64_t address, std::uint64_t size )
         {
-            do
+            std::vector< std::uint8_t > buffer( size );
+            std::uint64_t               done { 0 };
+
+            while ( done < size )
             {
-                if ( name == mod.szModule )
+                const auto chunk = std::min( m_scan.chunk, size - done );
+                const auto got   = m_target->read( address + done, buffer.data( ) + done, chunk );
+
+                done += got;
+                paced += chunk;
+
+                // hold the average rate to the budget, a client that is loading gets the time in between
+                if ( m_scan.budget )
                 {
-                    result = std::make_unique< module_t >( );
+                    const auto seconds = static_cast< double >( paced ) / static_cast< double >( m_scan.budget );
+                    const auto due     = std::chrono::duration< double >( seconds );
+                    std::this_thread::sleep_until( began + std::chrono::duration_cast< std::chrono::steady_clock::duration >( due ) );
+                }
+                else
+                    std::this_thread::yield( );
 
-                    result->base = reinterpret_cast< std::uint64_t >( mod.modBaseAddr );
-                    result->size = mod.modBaseSize;
-                    result->name = mod.szModule;
-                    result->path = mod.szExePath;
+                if ( got < chunk )
                     break;
-                }
-            } while ( Module32Next( snapshot, &mod ) );
+            }
+
+            buffer.resize( done );
+            m_scan_stats.bytes += done;
+
+            return buffer;
+        };
+
+        for ( const auto &run : resident )
+        {
+            const auto buffer = read_paced( run.base, run.end - run.base );
+            if ( !buffer.empty( ) and !callback( run.base, buffer ) )
+                return;
         }
 
-        CloseHandle( snapshot );
-        return result;
+        if ( deferred.empty( ) )
+            return;
+
+        m_scan_stats.fallback = true;
+
+        for ( const auto &run : deferred )
+        {
+            const auto base = std::max( run.low, run.base - std::min( run.base, c_target::page_size ) );
+            const auto end  = std::min( run.high, run.end + c_target::page_size );
+
+            const auto buffer = read_paced( base, end - base );
+            if ( !buffer.empty( ) and !callback( base, buffer ) )
+                return;
+        }
     }
 
-    std::uint64_t c_memory::find( const std::vector< std::uint8_t > &pattern ) const noexcept
+    std::uint64_t c_memory::heap( std::size_t overlap,
+                                  const std::function< void( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept
     {
-        const auto mod = module( constants::client_name );
-        if ( !mod or pattern.empty( ) )
-            return 0;
+        std::vector< std::pair< std::uint64_t, std::uint64_t > > chunks;
+        std::uint64_t                                            total { 0 };
 
-        std::uint64_t start = mod->base;
-        std::uint64_t end   = mod->base + mod->size;
+        // the heap has grown since the target was attached
+        m_target->refresh( );
 
-        MEMORY_BASIC_INFORMATION mbi { };
-
-        while ( start < end )
+        for ( std::uint64_t address = 0; address < user_limit; )
         {
-            if ( VirtualQueryEx( m_process, reinterpret_cast< void * >( start ), &mbi, sizeof( mbi ) ) == sizeof( mbi ) )
+            const auto region = m_target->query( address );
+            if ( !region )
+                break;
+
+            const auto end = region->base + region->size;
+
+            if ( region->committed and region->readable and !region->mapped )
             {
-                bool readable = ( mbi.State == MEM_COMMIT )
-                            and ( ( mbi.Protect & PAGE_READONLY ) or ( mbi.Protect & PAGE_READWRITE ) or ( mbi.Protect & PAGE_WRITECOPY )
-                                  or ( mbi.Protect & PAGE_EXECUTE_READ ) or ( mbi.Protect & PAGE_EXECUTE_READWRITE ) );
+                for ( auto start = region->base; start < end; start += heap_chunk )
+                    chunks.emplace_back( start, std::min( start + heap_chunk + overlap, end ) - start );
 
-                if ( readable )
-                {
-                    auto region_size = mbi.RegionSize;
-                    if ( start + region_size > end )
-                        region_size = end - start;
+                total += region->size;
+            }
 
-                    auto buffer = read( start, region_size );
-                    if ( buffer.empty( ) )
-                    {
-                        start += region_size;
-                        continue;
-                    }
+            address = std::max( end, address + 1 );
+        }
+
+        if ( chunks.empty( ) )
+            return 0;
+
+        std::atomic< std::size_t > next { 0 };
+        std::vector< std::thread > workers;
+
+        const auto worker_count = std::min< std::size_t >( std::max( std::thread::hardware_concurrency( ), 1u ), chunks.size( ) );
+
+        for ( std::size_t idx = 0; idx < worker_count; ++idx )
+        {
+            workers.emplace_back(
+                [ & ]
+                {
+                    std::vector< std::uint8_t > buffer;
 
-                    for ( std::size_t idx = 0; idx + pattern.size( ) <= buffer.size( ); ++idx )
+                    for ( auto job = next++; job < chunks.size( ); job = next++ )
                     {
-                        bool match = true;
+                        const auto [ base, size ] = chunks[ job ];
 
-                        for ( std::size_t pat_idx = 0; pat_idx < pattern.size( ); ++pat_idx )
+                        if ( const auto view = m_target->view( base, size ); view.size( ) == size )
                         {
-                            if ( pattern[ pat_idx ] != 0xcc and buffer[ idx + pat_idx ] != pattern[ pat_idx ] )
-                            {
-                                match = false;
-                                break;
-                            }
+                            callback( base, view );
+                            continue;
                         }
 
-                        if ( match )
-                            return start + idx;
+                        buffer.resize( size );
+
+                        if ( const auto bytes_read = m_target->read( base, buffer.data( ), size ); bytes_read != 0 )
+                            callback( base, std::span( buffer.data( ), bytes_read ) );
                     }
-                }
-                start += mbi.RegionSize;
-            }
-            else
-                start += 0x1000;
+                } );
         }
 
-        return 0;
+        for ( auto &worker : workers )
+            worker.join( );
+
+        return total;
     }
 
-    std::vector< std::uint64_t > c_memory::find_all( const std::vector< std::uint8_t > &pattern ) const noexcept
+    std::size_t c_memory::read_batch( std::span< read_request_t > requests ) const noexcept
     {
-        std::vector< std::uint64_t > results;
-
-        const auto mod = module( constants::client_name );
-        if ( !mod or pattern.empty( ) )
-            return results;
+        if ( requests.empty( ) )
+            return 0;
 
-        std::uint64_t start = mod->base;
-        std::uint64_t end   = mod->base + mod->size;
+        std::vector< std::size_t > order( requests.size( ) );
+        std::iota( order.begin( ), order.end( ), 0 );
+        std::ranges::sort( order, { },
+                           [ & ]( std::size_t idx )
+                           {
+                               return requests[ idx ].address;
+                           } );
 
-        MEMORY_BASIC_INFORMATION mbi { };
+        std::vector< read_request_t >              spans;
+        std::vector< std::vector< std::uint8_t > > buffers;
+        std::vector< std::size_t >                 owner( requests.size( ) );
 
-        while ( start < end )
+        for ( const auto idx : order )
         {
-            if ( VirtualQueryEx( m_process, reinterpret_cast< void * >( start ), &mbi, sizeof( mbi ) ) == sizeof( mbi ) )
+            const auto &request = requests[ idx ];
+            const auto  end     = request.address + request.size;
+
+            if ( !spans.empty( ) )
             {
-                bool readable = ( mbi.State == MEM_COMMIT )
-                            and ( ( mbi.Protect & PAGE_READONLY ) or ( mbi.Protect & PAGE_READWRITE ) or ( mbi.Protect & PAGE_WRITECOPY )
-                                  or ( mbi.Protect & PAGE_EXECUTE_READ ) or ( mbi.Protect & PAGE_EXECUTE_READWRITE ) );
+                auto &span = spans.back( );
 
-                if ( readable )
+                if ( request.address <= span.address + span.size + coalesce_gap and end - span.address <= coalesce_limit )
                 {
-                    auto region_size = mbi.RegionSize;
-                    if ( start + region_size > end )
-                        region_size = end - start;
+                    span.size    = std::max< std::uint64_t >( span.size, end - span.address );
+                    owner[ idx ] = spans.size( ) - 1;
+                    continue;
+                }
+            }
 
-                    auto buffer = read( start, region_size );
-                    if ( buffer.empty( ) )
-                    {
-                        start += region_size;
-                        continue;
-                    }
+            spans.push_back( { .address = request.address, .size = request.size } );
+            owner[ idx ] = spans.size( ) - 1;
+        }
 
-                    for ( std::size_t idx = 0; idx + pattern.size( ) <= buffer.size( ); ++idx )
-                    {
-                        bool match = true;
+        buffers.resize( spans.size( ) );
 
-                        for ( std::size_t pat_idx = 0; pat_idx < pattern.size( ); ++pat_idx )
-                        {
-                            if ( pattern[ pat_idx ] != 0xcc and buffer[ idx + pat_idx ] != pattern[ pat_idx ] )
-                            {
-                                match = false;
-                                break;
-                            }
-                        }
+        for ( std::size_t idx = 0; idx < spans.size( ); ++idx )
+        {
+            buffers[ idx ].resize( spans[ idx ].size );
+            spans[ idx ].buffer = buffers[ idx ].data( );
+        }
 
-                        if ( match )
-                            results.push_back( start + idx );
-                    }
-                }
-                start += mbi.RegionSize;
+        m_target->read_batch( spans );
+
+        const auto issued = spans.size( );
+
+        std::vector< read_request_t > retries;
+        std::vector< std::size_t >    retried;
+
+        for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+        {
+            auto       &request = requests[ idx ];
+            const auto &span    = spans[ owner[ idx ] ];
+            const auto  offset  = request.address - span.address;
+
+            // a merged span can come back short because of a hole between two requests, retry those on their own
+            if ( span.result < offset + request.size and span.size != request.size )
+            {
+                retries.push_back( request );
+                retried.push_back( idx );
+                continue;
             }
-            else
-                start += 0x1000;
+
+            request.result = std::min( request.size, span.result > offset ? span.result - offset : 0 );
+            std::memcpy( request.buffer, buffers[ owner[ idx ] ].data( ) + offset, request.result );
         }
 
-        return results;
+        if ( retries.empty( ) )
+            return issued;
+
+        m_target->read_batch( retries );
+
+        for ( std::size_t idx = 0; idx < retries.size( ); ++idx )
+            requests[ retried[ idx ] ].result = retries[ idx ].result;
+
+        return issued + retries.size( );
+    }
+
+    std::size_t c_memory::write_batch( std::span< write_request_t > requests ) const noexcept
+    {
+        if ( requests.empty( ) )
+            return 0;
+
+        std::vector< std::size_t > order( requests.size( ) );
+        std::iota( order.begin( ), order.end( ), 0 );
+        std::ranges::stable_sort( order, { },
+                                  [ & ]( std::size_t idx )
+                                  {
+                                      return requests[ idx ].address;
+                                  } );
+
+        std::vector< write_request_t >             spans;
+        std::vector< std::vector< std::uint8_t > > buffers;
+        std::vector< std::size_t >                 owner( requests.size( ) );
+
+        for ( const auto idx : order )
+        {
+            const auto &request = requests[ idx ];
+            const auto *bytes   = static_cast< const std::uint8_t * >( request.buffer );
+            const auto  end     = request.address + request.size;
+
+            // unlike reads, a hole cannot be bridged since its bytes would have to be written too
+            if ( !spans.empty( ) and request.address <= spans.back( ).address + spans.back( ).size
+                 and end - spans.back( ).address <= coalesce_limit )
+            {
+                auto &span   = spans.back( );
+                auto &buffer = buffers.back( );
+
+                if ( end - span.address > buffer.size( ) )
+                    buffer.resize( end - span.address );
+
+                std::memcpy( buffer.data( ) + ( request.address - span.address ), bytes, request.size );
+
+                span.size    = buffer.size( );
+                owner[ idx ] = spans.size( ) - 1;
+                continue;
+            }
+
+            spans.push_back( { .address = request.address, .size = request.size } );
+            buffers.emplace_back( bytes, bytes + request.size );
+            owner[ idx ] = spans.size( ) - 1;
+        }
+
+        for ( std::size_t idx = 0; idx < spans.size( ); ++idx )
+            spans[ idx ].buffer = buffers[ idx ].data( );
+
+        m_target->write_batch( spans );
+
+        if ( m_cache )
+        {
+            for ( const auto &span : spans )
+                m_cache->update( span.address, span.buffer, span.size, span.written );
+        }
+
+        for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+            requests[ idx ].written = spans[ owner[ idx ] ].written;
+
+        return spans.size( );
     }
 
     std::uint64_t c_memory::rebase( const std::uint64_t address, e_rebase_type rebase_type ) const noexcept
@@ -2,6 +2,11 @@
 
 #include "native.hpp"
 
+// local->misc
+#include "cache/cache.hpp"
+#include "signature/signature.hpp"
+#include "targets/target.hpp"
+
 namespace odessa
 {
     enum class e_rebase_type : std::uint8_t
@@ -10,27 +15,134 @@ namespace odessa
         add = 1
     };
 
-    struct module_t
+    struct scan_config_t
     {
-        std::uint64_t base { 0 }; ///< Base address of the module
-        std::uint32_t size { 0 }; ///< Size of the module in bytes
+        bool          low_impact { false }; ///< Pace module scans and read the pages resident in the client first
+        std::uint64_t budget { 0 };         ///< Bytes per second a low-impact scan may read, 0 to only yield between chunks
+        std::uint64_t chunk { 0x10000 };    ///< Bytes a low-impact scan reads between two pauses
+    };
+
+    struct scan_stats_t
+    {
+        std::uint64_t bytes { 0 };          ///< Bytes scanned, read from the target or viewed in place
+        std::uint64_t deferred { 0 };       ///< Bytes a low-impact scan left for later because they were not resident
+        bool          fallback { false };   ///< Whether the deferred bytes had to be read after all
+        double        milliseconds { 0.0 }; ///< Wall time of the walk
+
+        std::optional< footprint_t > before { }; ///< Footprint of the target before the walk
+        std::optional< footprint_t > after { };  ///< Footprint of the target after the walk
+
+        /**
+         * @brief Returns the page faults the target took during the walk, whether caused by it or not.
+         *
+         * @return The number of faults, or 0 if the backend cannot tell.
+         */
+        [[nodiscard]] std::uint64_t faults( ) const noexcept
+        {
+            return before and after and after->faults > before->faults ? after->faults - before->faults : 0;
+        }
 
-        std::string name { "" }; ///< Name of the module
-        std::string path { "" }; ///< Full path to the module
+        /**
+         * @brief Returns how much the target's working set grew during the walk.
+         *
+         * @return The growth in bytes, negative if it shrank, or 0 if the backend cannot tell.
+         */
+        [[nodiscard]] std::int64_t working_set( ) const noexcept
+        {
+            if ( !before or !after )
+                return 0;
+
+            return static_cast< std::int64_t >( after->working_set ) - static_cast< std::int64_t >( before->working_set );
+        }
     };
 
     class c_memory
     {
-        HANDLE       m_process { nullptr }; ///< Handle to the target process
-        std::int32_t m_pid { 0 };           ///< Process ID of the target process
+        std::unique_ptr< c_target >     m_target { nullptr }; ///< Backend the memory is accessed through
+        std::unique_ptr< c_page_cache > m_cache { nullptr };  ///< Optional cache serving small reads
+
+        scan_config_t        m_scan { };       ///< How regions() reads the module
+        mutable scan_stats_t m_scan_stats { }; ///< Counters of the last regions() walk
+
+        static constexpr std::uint64_t coalesce_gap { 0x40 };      ///< Largest hole merged into a batched read
+        static constexpr std::uint64_t coalesce_limit { 0x10000 }; ///< Largest span a batched read is merged into
+
+        static constexpr std::uint64_t heap_chunk { 0x400000 };      ///< Bytes of private memory a heap worker reads at once
+        static constexpr std::uint64_t user_limit { 0x800000000000 }; ///< End of the user mode address space
+
+        /**
+         * @brief Reads raw bytes, through the page cache when it is enabled.
+         *
+         * @param address The address to read from.
+         * @param buffer The destination buffer.
+         * @param size The number of bytes to read.
+         *
+         * @return The number of bytes read.
+         */
+        std::size_t read_raw( const std::uint64_t address, void *buffer, std::size_t size ) const noexcept
+        {
+            if ( m_cache )
+                return m_cache->read( *m_target, address, buffer, size );
+
+            return m_target->read( address, buffer, size );
+        }
+
+        /**
+         * @brief Writes raw bytes and keeps the page cache coherent.
+         *
+         * @param address The address to write to.
+         * @param buffer The source buffer.
+         * @param size The number of bytes to write.
+         *
+         * @return True if every byte was written, false otherwise.
+         */
+        bool write_raw( const std::uint64_t address, const void *buffer, std::size_t size ) const noexcept
+        {
+            const bool written = m_target->write( address, buffer, size );
+
+            if ( m_cache )
+                m_cache->update( address, buffer, size, written );
+
+            return written;
+        }
+
+        /**
+         * @brief Walks the readable regions of a module at full speed, one read per region.
+         *
+         * @param mod The module to walk.
+         * @param callback See regions().
+         */
+        void walk( const module_t                                                              &mod,
+                   const std::function< bool( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept;
+
+        /**
+         * @brief Walks the readable regions of a module in paced chunks, resident pages first.
+         *
+         * Runs of resident pages are handed to the callback as they are read. Only if the callback never stopped the
+         * walk are the remaining pages read, each run widened by a page on both sides so a match straddling the edge
+         * of a resident run is still seen whole.
+         *
+         * @param mod The module to walk.
+         * @param callback See regions().
+         */
+        void walk_paced( const module_t                                                              &mod,
+                         const std::function< bool( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept;
 
       public:
         /**
-         * @brief Retrieves the memory usage of a process by its name.
+         * @brief Waits for a process by its name and attaches to it.
+         *
+         * @param name The name of the process to attach to.
+         * @param timeout How long to wait for the process, the target is invalid if it did not appear in time.
+         */
+        c_memory( const std::string &name, std::chrono::milliseconds timeout = c_target::forever ) noexcept;
+
+        /**
+         * @brief Accesses memory through an existing backend, e.g. an offline image or minidump.
          *
-         * @param name The name of the process whose memory usage is to be retrieved.
+         * @param target The backend to use.
          */
-        c_memory( const std::string &name ) noexcept;
+        c_memory( std::unique_ptr< c_target > target ) noexcept;
 
         /**
          * @brief Destroys the c_memory object and releases any associated resources.
@@ -47,22 +159,120 @@ namespace odessa
         std::unique_ptr< module_t > module( const std::string &name ) const noexcept;
 
         /**
-         * @brief Scans the specified module for a pattern and returns the first match. 0xCC in the pattern is a wildcard.
+         * @brief Identifies the client build from the PE headers of the loaded module.
          *
-         * @param pattern Byte pattern to search for (0xCC is a wildcard).
+         * @return The build, or an invalid build_t if the module or its headers could not be read.
+         */
+        [[nodiscard]] build_t build( ) const noexcept;
+
+        /**
+         * @brief Walks every committed, readable region of the client module.
+         *
+         * Backends that can expose their memory directly (offline images and dumps) are scanned in place
+         * without copying. Otherwise the walk follows the scan configuration, see throttle(), and its counters
+         * are kept for scan_stats().
+         *
+         * @param callback Invoked with the base address and contents of each region. Return false to stop the walk.
+         */
+        void regions( const std::function< bool( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept;
+
+        /**
+         * @brief Walks every committed, readable private region of the target in parallel, i.e. the heaps.
+         *
+         * Regions are split into chunks that a pool of worker threads reads straight from the backend, bypassing
+         * the page cache. Consecutive chunks of a region overlap, so an object no larger than the overlap is seen
+         * whole by at least one chunk, possibly by two.
+         *
+         * @param overlap The number of bytes each chunk extends into the next one.
+         * @param callback Invoked concurrently from the workers with the base address and contents of each chunk.
+         *
+         * @return The number of bytes of private memory found.
+         */
+        std::uint64_t heap( std::size_t overlap,
+                            const std::function< void( std::uint64_t, std::span< const std::uint8_t > ) > &callback ) const noexcept;
+
+        /**
+         * @brief Scans the client module for a compile-time signature and returns the first match.
+         *
+         * @tparam signature_v The signature to search for, see signature_t.
          *
          * @return Address of the first match, or 0 if not found.
          */
-        std::uint64_t find( const std::vector< std::uint8_t > &pattern ) const noexcept;
+        template < auto signature_v >
+        [[nodiscard]] std::uint64_t find( ) const noexcept
+        {
+            std::uint64_t result { 0 };
+
+            regions(
+                [ & ]( std::uint64_t base, std::span< const std::uint8_t > buffer )
+                {
+                    const auto offset = signature::scan< signature_v >( buffer );
+                    if ( offset == std::string_view::npos )
+                        return true;
+
+                    result = base + offset;
+                    return false;
+                } );
+
+            return result;
+        }
+
+        /**
+         * @brief Scans the client module for every occurrence of a compile-time signature.
+         *
+         * @tparam signature_v The signature to search for, see signature_t.
+         *
+         * @return Vector of addresses where the signature was found.
+         */
+        template < auto signature_v >
+        [[nodiscard]] std::vector< std::uint64_t > find_all( ) const noexcept
+        {
+            std::vector< std::uint64_t > results;
+
+            regions(
+                [ & ]( std::uint64_t base, std::span< const std::uint8_t > buffer )
+                {
+                    auto offset = signature::scan< signature_v >( buffer );
+
+                    while ( offset != std::string_view::npos )
+                    {
+                        results.push_back( base + offset );
+                        offset = signature::scan< signature_v >( buffer, offset + 1 );
+                    }
+
+                    return true;
+                } );
+
+            // a low-impact walk may hand the edge of a resident run to the callback twice
+            std::ranges::sort( results );
+            results.erase( std::unique( results.begin( ), results.end( ) ), results.end( ) );
+
+            return results;
+        }
 
         /**
-         * @brief Scans the specified module for a pattern. 0xCC in the pattern is a wildcard.
+         * @brief Follows the rip-relative recipe of a signature from a match to its target address.
          *
-         * @param pattern Byte pattern to search for (0xCC is a wildcard).
+         * @tparam signature_v The signature the match was produced by. It must carry a relative_t recipe.
+         * @param address The address of the match, as returned by find().
          *
-         * @return Vector of addresses where the pattern was found.
+         * @return The absolute address referenced by the instruction, or 0 if address is 0.
          */
-        std::vector< std::uint64_t > find_all( const std::vector< std::uint8_t > &pattern ) const noexcept;
+        template < auto signature_v >
+        [[nodiscard]] std::uint64_t resolve( const std::uint64_t address ) const noexcept
+        {
+            constexpr auto relative = signature_v.relative;
+
+            static_assert( relative.valid( ), "signature has no rip-relative recipe" );
+
+            if ( !address )
+                return 0;
+
+            const auto instruction  = address + relative.offset;
+            const auto displacement = read< std::int32_t >( instruction + relative.displacement );
+
+            return instruction + relative.length + displacement;
+        }
 
         /**
          * @brief Returns the rebased value of the given address.
@@ -86,7 +296,7 @@ namespace odessa
         [[nodiscard]] type_t read( const std::uint64_t address ) const noexcept
         {
             type_t buffer { };
-            ReadProcessMemory( m_process, reinterpret_cast< void * >( address ), &buffer, sizeof( type_t ), nullptr );
+            read_raw( address, &buffer, sizeof( type_t ) );
             return buffer;
         }
 
@@ -105,9 +315,8 @@ namespace odessa
 
             std::vector< std::uint8_t > buffer( size );
 
-            std::size_t bytes_read { 0 };
-
-            if ( !ReadProcessMemory( m_process, reinterpret_cast< void * >( address ), buffer.data( ), size, &bytes_read ) )
+            const auto bytes_read = read_raw( address, buffer.data( ), size );
+            if ( bytes_read == 0 )
                 return { };
 
             if ( bytes_read < size )
@@ -116,6 +325,31 @@ namespace odessa
             return buffer;
         }
 
+        /**
+         * @brief Reads many ranges at once, merging neighbouring ranges into single reads.
+         *
+         * Requests are sorted and coalesced into spans, the spans are issued as one batch to the target,
+         * and the bytes are scattered back. Spans that come back short are retried per request. Batches
+         * bypass the page cache.
+         *
+         * @param requests The ranges to read. Each request's result is filled in.
+         *
+         * @return The number of reads issued to the target.
+         */
+        std::size_t read_batch( std::span< read_request_t > requests ) const noexcept;
+
+        /**
+         * @brief Writes many ranges at once, merging adjacent ranges into single writes.
+         *
+         * Requests are sorted and ranges that touch or overlap are merged into spans, where later requests win,
+         * then the spans are issued as one batch to the target and the page cache is kept coherent.
+         *
+         * @param requests The ranges to write. Each request's written flag is filled in.
+         *
+         * @return The number of writes issued to the target.
+         */
+        std::size_t write_batch( std::span< write_request_t > requests ) const noexcept;
+
         /**
          * @brief Writes data to the target process's memory at the specified address.
          *
@@ -128,7 +362,7 @@ namespace odessa
         template < typename type_t >
         [[nodiscard]] bool write( const std::uint64_t address, const type_t &value ) const noexcept
         {
-            return WriteProcessMemory( m_process, reinterpret_cast< void * >( address ), &value, sizeof( type_t ), nullptr ) != 0;
+            return write_raw( address, &value, sizeof( type_t ) );
         }
 
         /**
@@ -144,17 +378,80 @@ namespace odessa
         template < typename type_t >
         [[nodiscard]] bool write( const std::uint64_t address, const type_t &value, std::size_t size ) const noexcept
         {
-            return WriteProcessMemory( m_process, reinterpret_cast< void * >( address ), &value, size, nullptr ) != 0;
+            return write_raw( address, &value, size );
+        }
+
+        /**
+         * @brief Enables the page cache for small reads, replacing any existing cache.
+         *
+         * @param config The cache configuration.
+         */
+        void cache( const cache_config_t &config = { } ) noexcept
+        {
+            m_cache = std::make_unique< c_page_cache >( config );
+        }
+
+        /**
+         * @brief Sets how module scans read the client, see scan_config_t.
+         *
+         * A low-impact scan reads in chunks paced to the byte budget and yields in between, so it does not compete
+         * with a loading client for memory bandwidth. It also reads the pages already in the client's working set
+         * first and only faults the rest in if nothing was found there.
+         *
+         * @param config The scan configuration.
+         */
+        void throttle( const scan_config_t &config ) noexcept
+        {
+            m_scan = config;
+        }
+
+        /**
+         * @brief Returns the counters of the last regions() walk.
+         *
+         * @return The counters.
+         */
+        [[nodiscard]] const scan_stats_t &scan_stats( ) const noexcept
+        {
+            return m_scan_stats;
+        }
+
+        /**
+         * @brief Records every call issued to the backend from now on into a trace file, see c_recording_target.
+         *
+         * @param path The path of the trace file to create.
+         */
+        void record( const std::string &path ) noexcept;
+
+        /**
+         * @brief Drops every cached page by starting a new cache epoch. Does nothing if the cache is disabled.
+         */
+        void invalidate( ) const noexcept
+        {
+            if ( m_cache )
+                m_cache->invalidate( );
+        }
+
+        /**
+         * @brief Returns the page cache counters.
+         *
+         * @return The counters, or std::nullopt if the cache is disabled.
+         */
+        [[nodiscard]] std::optional< cache_stats_t > cache_stats( ) const noexcept
+        {
+            if ( !m_cache )
+                return std::nullopt;
+
+            return m_cache->stats( );
         }
 
         /**
-         * @brief Returns the process handle associated with the object.
+         * @brief Returns the backend the memory is accessed through.
          *
-         * @return The HANDLE representing the process.
+         * @return A reference to the target.
          */
-        [[nodiscard]] HANDLE handle( ) const noexcept
+        [[nodiscard]] const c_target &target( ) const noexcept
         {
-            return m_process;
+            return *m_target;
         }
 
         /**
@@ -164,7 +461,7 @@ namespace odessa
          */
         [[nodiscard]] std::int32_t pid( ) const noexcept
         {
-            return m_pid;
+            return m_target->pid( );
         }
     };
 
@@ -0,0 +1,118 @@
+#include "offsets.hpp"
+
+namespace odessa
+{
+    namespace
+    {
+        constexpr auto lock_name = "odessa-offsets"; ///< Guards every access to the mapped file
+
+        std::filesystem::path cache_path( ) noexcept
+        {
+            std::error_code error;
+            const auto      directory = std::filesystem::temp_directory_path( error );
+
+            return error ? std::filesystem::path( ) : directory / "odessa-offsets.bin";
+        }
+    } // namespace
+
+    c_offset_cache::c_offset_cache( ) noexcept
+    {
+        const auto path = cache_path( );
+        if ( path.empty( ) )
+            return;
+
+        m_handle = CreateFileW( path.c_str( ), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS,
+                                FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( m_handle == INVALID_HANDLE_VALUE )
+            return;
+
+        // a mapping larger than the file grows it, a fresh file reads back as zeroes and is prepared on first use
+        m_mapping = CreateFileMappingA( m_handle, nullptr, PAGE_READWRITE, 0, sizeof( offset_file_t ), nullptr );
+        if ( !m_mapping )
+            return;
+
+        const auto view = MapViewOfFile( m_mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, sizeof( offset_file_t ) );
+        m_file          = static_cast< offset_file_t * >( view );
+    }
+
+    c_offset_cache::~c_offset_cache( ) noexcept
+    {
+        if ( m_file )
+            UnmapViewOfFile( m_file );
+
+        if ( m_mapping )
+            CloseHandle( m_mapping );
+
+        if ( m_handle != INVALID_HANDLE_VALUE )
+            CloseHandle( m_handle );
+    }
+
+    void c_offset_cache::prepare( ) noexcept
+    {
+        if ( m_file->magic == file_magic and m_file->version == file_version )
+            return;
+
+        *m_file         = { };
+        m_file->magic   = file_magic;
+        m_file->version = file_version;
+    }
+
+    std::optional< std::uint64_t > c_offset_cache::find( const build_t &build ) noexcept
+    {
+        if ( !m_file or !build.valid( ) )
+            return std::nullopt;
+
+        const c_named_lock lock( lock_name, lock_timeout );
+        if ( !lock )
+            return std::nullopt;
+
+        prepare( );
+
+        for ( auto &slot : m_file->slots )
+        {
+            if ( slot.build != build or !slot.offset )
+                continue;
+
+            slot.used = ++m_file->clock;
+            return slot.offset;
+        }
+
+        return std::nullopt;
+    }
+
+    void c_offset_cache::store( const build_t &build, std::uint64_t offset ) noexcept
+    {
+        if ( !m_file or !build.valid( ) or !offset )
+            return;
+
+        const c_named_lock lock( lock_name, lock_timeout );
+        if ( !lock )
+            return;
+
+        prepare( );
+
+        auto *target = &m_file->slots.front( );
+
+        for ( auto &slot : m_file->slots )
+        {
+            if ( slot.build == build )
+            {
+                target = &slot;
+                break;
+            }
+
+            if ( slot.used < target->used )
+                target = &slot;
+        }
+
+        *target = { .build = build, .offset = offset, .used = ++m_file->clock };
+    }
+
+    std::unique_ptr< c_named_lock > c_offset_cache::claim( const build_t &build ) noexcept
+    {
+        if ( !build.valid( ) )
+            return nullptr;
+
+        return std::make_unique< c_named_lock >( std::format( "odessa-scan-{:08x}-{:08x}", build.timestamp, build.size ), claim_timeout );
+    }
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "lock/lock.hpp"
+#include "targets/target.hpp"
+
+namespace odessa
+{
+    struct offset_slot_t
+    {
+        build_t       build { };    ///< Build the offset was resolved for
+        std::uint64_t offset { 0 }; ///< Offset of the singleton pointer from the module base
+        std::uint64_t used { 0 };   ///< Value of offset_file_t::clock when the slot was last stored or found
+    };
+
+    struct offset_file_t
+    {
+        std::uint32_t                   magic { 0 };   ///< Identifies an initialized file
+        std::uint32_t                   version { 0 }; ///< Layout version, a mismatch resets the file
+        std::uint64_t                   clock { 0 };   ///< Bumped on every access, orders slots by last use
+        std::array< offset_slot_t, 32 > slots { };     ///< One slot per build, the least recently used is replaced
+    };
+
+    class c_offset_cache
+    {
+        static constexpr std::uint32_t file_magic { 0x6173646f };                             ///< "odsa" as stored on disk
+        static constexpr std::uint32_t file_version { 1 };                                    ///< Current layout version
+        static constexpr auto          lock_timeout { std::chrono::milliseconds( 1000 ) };   ///< Wait for the file lock
+        static constexpr auto          claim_timeout { std::chrono::milliseconds( 60000 ) }; ///< Wait for another instance's scan
+
+        offset_file_t *m_file { nullptr }; ///< Shared view of the file
+
+        HANDLE m_handle { INVALID_HANDLE_VALUE }; ///< Handle to the cache file
+        HANDLE m_mapping { nullptr };             ///< Handle to the file mapping object
+
+        /**
+         * @brief Resets the file if it was just created or has another layout. Requires the file lock.
+         */
+        void prepare( ) noexcept;
+
+      public:
+        /**
+         * @brief Maps the offset cache shared by every instance on the machine, creating it if needed.
+         *
+         * The file lives in the temporary directory rather than next to the tool, so instances started from different
+         * directories or with different configurations still share it.
+         */
+        c_offset_cache( ) noexcept;
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~c_offset_cache( ) noexcept;
+
+        c_offset_cache( const c_offset_cache & )             = delete;
+        c_offset_cache &operator=( const c_offset_cache & ) = delete;
+
+        /**
+         * @brief Looks up the singleton offset resolved for a build.
+         *
+         * @param build The build of the attached client.
+         *
+         * @return The offset, or std::nullopt if no instance has resolved this build yet.
+         */
+        [[nodiscard]] std::optional< std::uint64_t > find( const build_t &build ) noexcept;
+
+        /**
+         * @brief Stores the singleton offset resolved for a build, replacing the least recently used slot if it is new.
+         *
+         * @param build The build of the attached client.
+         * @param offset The singleton's offset from the module base.
+         */
+        void store( const build_t &build, std::uint64_t offset ) noexcept;
+
+        /**
+         * @brief Claims the right to scan a build, waiting while another instance holds it.
+         *
+         * Only one instance scans a given build at a time. The others block here until it has stored its result, then
+         * find() it instead of scanning the same module again. Different builds are claimed independently.
+         *
+         * @param build The build about to be scanned.
+         *
+         * @return The claim, released when it is destroyed, or nullptr if the build could not be identified. The claim
+         *         is not held if the wait timed out.
+         */
+        [[nodiscard]] static std::unique_ptr< c_named_lock > claim( const build_t &build ) noexcept;
+
+        /**
+         * @brief Checks whether the file was mapped successfully.
+         *
+         * @return True if the mapping is valid, false otherwise.
+         */
+        explicit operator bool ( ) const noexcept
+        {
+            return m_file != nullptr;
+        }
+    };
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "native.hpp"
+
+namespace odessa
+{
+    struct relative_t
+    {
+        std::uint32_t offset { 0 };       ///< Offset of the instruction from the start of the match
+        std::uint32_t displacement { 0 }; ///< Offset of the 32-bit displacement inside the instruction
+        std::uint32_t length { 0 };       ///< Total length of the instruction
+
+        /**
+         * @brief Checks whether a resolution recipe has been attached.
+         *
+         * @return True if the recipe describes an instruction, false otherwise.
+         */
+        [[nodiscard]] constexpr bool valid( ) const noexcept
+        {
+            return length != 0;
+        }
+    };
+
+    template < std::size_t size_v >
+    struct fixed_string_t
+    {
+        char data[ size_v ] { }; ///< Characters of the literal, including the null terminator
+
+        /**
+         * @brief Captures a string literal so it can be used as a template argument.
+         *
+         * @param string The string literal to capture.
+         */
+        consteval fixed_string_t( const char ( &string )[ size_v ] ) noexcept
+        {
+            std::copy_n( string, size_v, data );
+        }
+    };
+
+    template < std::size_t size_v >
+    struct signature_t
+    {
+        std::array< std::uint8_t, size_v > value { }; ///< Expected bytes, wildcard nibbles are zeroed
+        std::array< std::uint8_t, size_v > mask { };  ///< Per-byte masks (0xff exact, 0xf0 / 0x0f nibble, 0x00 wildcard)
+        relative_t                         relative { }; ///< Optional rip-relative resolution recipe
+
+        /**
+         * @brief Returns the number of bytes covered by the signature.
+         *
+         * @return The signature length in bytes.
+         */
+        [[nodiscard]] static constexpr std::size_t size( ) noexcept
+        {
+            return size_v;
+        }
+
+        /**
+         * @brief Attaches a rip-relative resolution recipe to the signature.
+         *
+         * @param offset Offset of the instruction from the start of the match.
+         * @param displacement Offset of the 32-bit displacement inside the instruction.
+         * @param length Total length of the instruction.
+         *
+         * @return A copy of the signature carrying the recipe.
+         */
+        [[nodiscard]] constexpr signature_t with_relative( std::uint32_t offset, std::uint32_t displacement,
+                                                           std::uint32_t length ) const noexcept
+        {
+            auto result     = *this;
+            result.relative = { offset, displacement, length };
+            return result;
+        }
+
+        /**
+         * @brief Returns the index of the first fully specified byte, used to skip ahead with memchr.
+         *
+         * @return The index of the anchor byte, or size_v if every byte is (partially) wildcarded.
+         */
+        [[nodiscard]] constexpr std::size_t anchor( ) const noexcept
+        {
+            for ( std::size_t idx = 0; idx < size_v; ++idx )
+            {
+                if ( mask[ idx ] == 0xff )
+                    return idx;
+            }
+
+            return size_v;
+        }
+
+        /**
+         * @brief Checks the signature against a buffer at runtime.
+         *
+         * @param bytes Pointer to at least size_v readable bytes.
+         *
+         * @return True if every byte matches under its mask, false otherwise.
+         */
+        [[nodiscard]] constexpr bool match( const std::uint8_t *bytes ) const noexcept
+        {
+            for ( std::size_t idx = 0; idx < size_v; ++idx )
+            {
+                if ( ( bytes[ idx ] & mask[ idx ] ) != value[ idx ] )
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+    namespace signature
+    {
+        /**
+         * @brief Converts a single hexadecimal character into its nibble value.
+         *
+         * @param character The character to convert.
+         *
+         * @return The nibble value. Invalid characters fail constant evaluation.
+         */
+        consteval std::uint8_t nibble( char character )
+        {
+            if ( character >= '0' and character <= '9' )
+                return static_cast< std::uint8_t >( character - '0' );
+
+            if ( character >= 'a' and character <= 'f' )
+                return static_cast< std::uint8_t >( character - 'a' + 10 );
+
+            if ( character >= 'A' and character <= 'F' )
+                return static_cast< std::uint8_t >( character - 'A' + 10 );
+
+            throw "invalid character in signature";
+        }
+
+        /**
+         * @brief Counts the whitespace separated tokens of an IDA-style signature.
+         *
+         * @param string The null terminated signature string.
+         *
+         * @return The number of bytes described by the string.
+         */
+        consteval std::size_t count( const char *string )
+        {
+            std::size_t tokens { 0 };
+            bool        inside { false };
+
+            for ( ; *string; ++string )
+            {
+                const bool space = *string == ' ';
+
+                if ( !space and !inside )
+                    ++tokens;
+
+                inside = !space;
+            }
+
+            return tokens;
+        }
+
+        /**
+         * @brief Parses an IDA-style signature ("48 8B 0D ?? ?? 4? ?C") into value / mask arrays.
+         *
+         * A single "?" is a full wildcard, "??" as well, and "4?" / "?C" are nibble wildcards.
+         *
+         * @tparam size_v Number of bytes in the signature, see count().
+         * @param string The null terminated signature string.
+         *
+         * @return The parsed signature.
+         */
+        template < std::size_t size_v >
+        consteval signature_t< size_v > parse( const char *string )
+        {
+            signature_t< size_v > result { };
+
+            std::size_t idx { 0 };
+
+            while ( *string )
+            {
+                if ( *string == ' ' )
+                {
+                    ++string;
+                    continue;
+                }
+
+                std::uint8_t value { 0 };
+                std::uint8_t mask { 0 };
+
+                const char high = string[ 0 ];
+                const char low  = ( string[ 1 ] and string[ 1 ] != ' ' ) ? string[ 1 ] : '\0';
+
+                if ( !low )
+                {
+                    if ( high != '?' )
+                        throw "single character tokens must be wildcards";
+                }
+                else
+                {
+                    if ( high != '?' )
+                    {
+                        value |= static_cast< std::uint8_t >( nibble( high ) << 4 );
+                        mask |= 0xf0;
+                    }
+
+                    if ( low != '?' )
+                    {
+                        value |= nibble( low );
+                        mask |= 0x0f;
+                    }
+                }
+
+                result.value[ idx ] = value;
+                result.mask[ idx ]  = mask;
+                ++idx;
+
+                string += low ? 2 : 1;
+
+                if ( *string and *string != ' ' )
+                    throw "signature tokens must be at most two characters";
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Verifies one byte of a compile-time signature. Wildcards compile away entirely.
+         */
+        template < auto signature_v, std::size_t index_v >
+        [[nodiscard]] inline bool verify_byte( const std::uint8_t *bytes ) noexcept
+        {
+            constexpr auto mask  = signature_v.mask[ index_v ];
+            constexpr auto value = signature_v.value[ index_v ];
+
+            if constexpr ( mask == 0x00 )
+                return true;
+            else if constexpr ( mask == 0xff )
+                return bytes[ index_v ] == value;
+            else
+                return ( bytes[ index_v ] & mask ) == value;
+        }
+
+        /**
+         * @brief Verifies a compile-time signature with the comparison fully unrolled.
+         */
+        template < auto signature_v, std::size_t... index_v >
+        [[nodiscard]] inline bool verify( const std::uint8_t *bytes, std::index_sequence< index_v... > ) noexcept
+        {
+            return ( verify_byte< signature_v, index_v >( bytes ) and ... );
+        }
+
+        /**
+         * @brief Finds the next occurrence of a compile-time signature inside a buffer.
+         *
+         * The first fully specified byte is located with memchr, then the remaining bytes are
+         * checked with an unrolled comparison specialized on the signature.
+         *
+         * @tparam signature_v The signature to search for.
+         * @param buffer The buffer to scan.
+         * @param from The offset to start scanning from.
+         *
+         * @return The offset of the match, or std::string_view::npos if there is none.
+         */
+        template < auto signature_v >
+        [[nodiscard]] std::size_t scan( std::span< const std::uint8_t > buffer, std::size_t from = 0 ) noexcept
+        {
+            constexpr auto size   = signature_v.size( );
+            constexpr auto anchor = signature_v.anchor( );
+
+            static_assert( size > 0, "signature must not be empty" );
+
+            if ( buffer.size( ) < size )
+                return std::string_view::npos;
+
+            const auto last = buffer.size( ) - size;
+
+            for ( auto idx = from; idx <= last; ++idx )
+            {
+                if constexpr ( anchor < size )
+                {
+                    const auto *found = static_cast< const std::uint8_t * >(
+                        std::memchr( buffer.data( ) + idx + anchor, signature_v.value[ anchor ], last - idx + 1 ) );
+
+                    if ( !found )
+                        return std::string_view::npos;
+
+                    idx = static_cast< std::size_t >( found - buffer.data( ) ) - anchor;
+                }
+
+                if ( verify< signature_v >( buffer.data( ) + idx, std::make_index_sequence< size > { } ) )
+                    return idx;
+            }
+
+            return std::string_view::npos;
+        }
+    } // namespace signature
+
+    namespace literals
+    {
+        /**
+         * @brief Parses an IDA-style signature literal at compile time, e.g. "48 8B 0D ?? ?? ?? ??"_sig.
+         *
+         * @return The parsed signature_t.
+         */
+        template < fixed_string_t string_v >
+        consteval auto operator""_sig( )
+        {
+            return signature::parse< signature::count( string_v.data ) >( string_v.data );
+        }
+    } // namespace literals
+} // namespace odessa
\ No newline at end of file
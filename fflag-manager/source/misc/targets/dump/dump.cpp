@@ -0,0 +1,99 @@
+#include "dump.hpp"
+
+namespace odessa
+{
+    std::string c_dump_target::string( std::uint32_t rva ) const noexcept
+    {
+        const auto *length = m_mapping.at< std::uint32_t >( rva );
+        if ( !length )
+            return { };
+
+        const auto *characters = m_mapping.at< std::uint16_t >( rva + sizeof( std::uint32_t ), *length / sizeof( std::uint16_t ) );
+        if ( !characters )
+            return { };
+
+        std::string result;
+        result.reserve( *length / sizeof( std::uint16_t ) );
+
+        for ( const auto character : std::span( characters, *length / sizeof( std::uint16_t ) ) )
+            result.push_back( character < 0x80 ? static_cast< char >( character ) : '?' );
+
+        return result;
+    }
+
+    c_dump_target::c_dump_target( const std::string &path ) noexcept : c_mapped_target( path )
+    {
+        const auto *header = m_mapping.at< dump_header_t >( 0 );
+        if ( !header or header->signature != 0x504d444d )
+            return;
+
+        const auto *directory = m_mapping.at< dump_directory_t >( header->directory, header->stream_count );
+        if ( !directory )
+            return;
+
+        for ( const auto &stream : std::span( directory, header->stream_count ) )
+        {
+            switch ( stream.type )
+            {
+                case e_stream_type::module_list :
+                {
+                    const auto *count   = m_mapping.at< std::uint32_t >( stream.rva );
+                    const auto *modules = count ? m_mapping.at< dump_module_t >( stream.rva + sizeof( std::uint32_t ), *count ) : nullptr;
+                    if ( !modules )
+                        break;
+
+                    for ( const auto &mod : std::span( modules, *count ) )
+                    {
+                        auto full_path = string( mod.name );
+                        auto name      = full_path.substr( full_path.find_last_of( "\\/" ) + 1 );
+
+                        m_modules.push_back( {
+                            .base = mod.base,
+                            .size = mod.size,
+                            .name = std::move( name ),
+                            .path = std::move( full_path ),
+                        } );
+                    }
+                    break;
+                }
+                case e_stream_type::memory_list :
+                {
+                    const auto *count  = m_mapping.at< std::uint32_t >( stream.rva );
+                    const auto *memory = count ? m_mapping.at< dump_memory_t >( stream.rva + sizeof( std::uint32_t ), *count ) : nullptr;
+                    if ( !memory )
+                        break;
+
+                    for ( const auto &range : std::span( memory, *count ) )
+                        m_ranges.push_back( { .base = range.base, .size = range.size, .offset = range.rva, .length = range.size } );
+
+                    break;
+                }
+                case e_stream_type::memory64_list :
+                {
+                    const auto *list = m_mapping.at< std::uint64_t >( stream.rva, 2 );
+                    if ( !list )
+                        break;
+
+                    const auto  count  = list[ 0 ];
+                    const auto *memory = m_mapping.at< dump_memory64_t >( stream.rva + sizeof( std::uint64_t ) * 2, count );
+                    if ( !memory )
+                        break;
+
+                    // full-memory dumps store every range back to back, starting at the base rva
+                    auto offset = list[ 1 ];
+
+                    for ( const auto &range : std::span( memory, count ) )
+                    {
+                        m_ranges.push_back( { .base = range.base, .size = range.size, .offset = offset, .length = range.size } );
+                        offset += range.size;
+                    }
+                    break;
+                }
+                default :
+                    break;
+            }
+        }
+
+        finalize( );
+    }
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "targets/mapped/mapped.hpp"
+
+namespace odessa
+{
+    enum class e_stream_type : std::uint32_t
+    {
+        module_list   = 4, ///< MINIDUMP_MODULE_LIST
+        memory_list   = 5, ///< MINIDUMP_MEMORY_LIST (descriptors with individual RVAs)
+        memory64_list = 9  ///< MINIDUMP_MEMORY64_LIST (descriptors laid out back to back from a base RVA)
+    };
+
+#pragma pack( push, 4 )
+    struct dump_header_t
+    {
+        std::uint32_t signature;    ///< +0x00 "MDMP"
+        std::uint32_t version;      ///< +0x04 Format version
+        std::uint32_t stream_count; ///< +0x08 Number of streams in the directory
+        std::uint32_t directory;    ///< +0x0c RVA of the stream directory
+    };
+
+    struct dump_directory_t
+    {
+        e_stream_type type; ///< +0x00 Stream type
+        std::uint32_t size; ///< +0x04 Size of the stream in bytes
+        std::uint32_t rva;  ///< +0x08 RVA of the stream
+    };
+
+    struct dump_module_t
+    {
+        std::uint64_t base;          ///< +0x00 Base address of the module
+        std::uint32_t size;          ///< +0x08 Size of the module in bytes
+        std::uint32_t checksum;      ///< +0x0c Image checksum
+        std::uint32_t timestamp;     ///< +0x10 Link timestamp
+        std::uint32_t name;          ///< +0x14 RVA of the module path (MINIDUMP_STRING)
+        std::uint8_t  gap_0[ 0x54 ]; ///< +0x18 Version info, CodeView / misc records, reserved
+    };
+
+    struct dump_memory_t
+    {
+        std::uint64_t base; ///< +0x00 Start of the captured range
+        std::uint32_t size; ///< +0x08 Size of the captured range
+        std::uint32_t rva;  ///< +0x0c RVA of the captured bytes
+    };
+
+    struct dump_memory64_t
+    {
+        std::uint64_t base; ///< +0x00 Start of the captured range
+        std::uint64_t size; ///< +0x08 Size of the captured range
+    };
+#pragma pack( pop )
+
+    class c_dump_target : public c_mapped_target
+    {
+        /**
+         * @brief Reads a MINIDUMP_STRING and narrows it to ASCII.
+         *
+         * @param rva The RVA of the string.
+         *
+         * @return The string, or an empty string if it is out of bounds.
+         */
+        [[nodiscard]] std::string string( std::uint32_t rva ) const noexcept;
+
+      public:
+        /**
+         * @brief Maps a minidump and exposes its captured memory ranges and module list.
+         *
+         * @param path The path of the minidump.
+         */
+        c_dump_target( const std::string &path ) noexcept;
+    };
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "image.hpp"
+
+// local->misc
+#include "constants.hpp"
+
+namespace odessa
+{
+    c_image_target::c_image_target( const std::string &path ) noexcept : c_mapped_target( path )
+    {
+        if ( !m_mapping )
+            return;
+
+        const auto *dos_lfanew = m_mapping.at< std::uint32_t >( 0x3c );
+        if ( !dos_lfanew or m_mapping.bytes( )[ 0 ] != 'M' or m_mapping.bytes( )[ 1 ] != 'Z' )
+            return;
+
+        const auto *file_header = m_mapping.at< pe_file_header_t >( *dos_lfanew );
+        if ( !file_header or file_header->signature != 0x4550 )
+            return;
+
+        const auto  optional_offset = *dos_lfanew + sizeof( pe_file_header_t );
+        const auto *optional_header = m_mapping.at< pe_optional_header_t >( optional_offset );
+        if ( !optional_header or optional_header->magic != 0x20b )
+            return;
+
+        const auto *sections = m_mapping.at< pe_section_header_t >( optional_offset + file_header->optional_size, file_header->section_count );
+        if ( !sections )
+            return;
+
+        const auto image_base = optional_header->image_base;
+
+        m_timestamp = file_header->timestamp;
+
+        m_ranges.push_back( {
+            .base   = image_base,
+            .size   = optional_header->headers_size,
+            .offset = 0,
+            .length = optional_header->headers_size,
+        } );
+
+        for ( const auto &section : std::span( sections, file_header->section_count ) )
+        {
+            constexpr std::uint32_t mem_read  = 0x40000000;
+            constexpr std::uint32_t mem_write = 0x80000000;
+
+            m_ranges.push_back( {
+                .base     = image_base + section.virtual_address,
+                .size     = std::max( section.virtual_size, section.raw_size ),
+                .offset   = section.raw_offset,
+                .length   = std::min( section.virtual_size ? section.virtual_size : section.raw_size, section.raw_size ),
+                .readable = ( section.characteristics & mem_read ) != 0,
+                .writable = ( section.characteristics & mem_write ) != 0,
+            } );
+        }
+
+        finalize( );
+
+        m_modules.push_back( {
+            .base = image_base,
+            .size = optional_header->image_size,
+            .name = constants::client_name,
+            .path = path,
+        } );
+    }
+} // namespace odessa
\ No newline at end of file
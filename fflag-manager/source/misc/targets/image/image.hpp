@@ -0,0 +1,69 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "targets/mapped/mapped.hpp"
+
+namespace odessa
+{
+#pragma pack( push, 1 )
+    struct pe_file_header_t
+    {
+        std::uint32_t signature;          ///< +0x00 "PE\0\0"
+        std::uint16_t machine;            ///< +0x04 Target machine
+        std::uint16_t section_count;      ///< +0x06 Number of section headers
+        std::uint32_t timestamp;          ///< +0x08 Link timestamp
+        std::uint8_t  gap_0[ 0x8 ];       ///< +0x0c Gap / Padding
+        std::uint16_t optional_size;      ///< +0x14 Size of the optional header
+        std::uint16_t characteristics;    ///< +0x16 Image characteristics
+    };
+
+    struct pe_optional_header_t
+    {
+        std::uint16_t magic;         ///< +0x00 0x20b for PE32+
+        std::uint8_t  gap_0[ 0x16 ]; ///< +0x02 Gap / Padding
+        std::uint64_t image_base;    ///< +0x18 Preferred load address
+        std::uint8_t  gap_1[ 0x18 ]; ///< +0x20 Gap / Padding
+        std::uint32_t image_size;    ///< +0x38 Size of the image once loaded
+        std::uint32_t headers_size;  ///< +0x3c Size of the headers rounded to file alignment
+    };
+
+    struct pe_section_header_t
+    {
+        char          name[ 0x8 ];     ///< +0x00 Section name
+        std::uint32_t virtual_size;    ///< +0x08 Size of the section once loaded
+        std::uint32_t virtual_address; ///< +0x0c RVA of the section
+        std::uint32_t raw_size;        ///< +0x10 Size of the section in the file
+        std::uint32_t raw_offset;      ///< +0x14 File offset of the section
+        std::uint8_t  gap_0[ 0xc ];    ///< +0x18 Gap / Padding
+        std::uint32_t characteristics; ///< +0x24 Section flags
+    };
+#pragma pack( pop )
+
+    class c_image_target : public c_mapped_target
+    {
+        std::uint32_t m_timestamp { 0 }; ///< Link timestamp of the image
+
+      public:
+        /**
+         * @brief Maps a PE file from disk and lays its sections out at their RVAs from the preferred image base.
+         *
+         * The image is exposed as the only module of the target. Since executables are often renamed when
+         * archived per build, it is reported under the name of constants::client_name.
+         *
+         * @param path The path of the PE file.
+         */
+        c_image_target( const std::string &path ) noexcept;
+
+        /**
+         * @brief Returns the link timestamp of the image.
+         *
+         * @return The timestamp from the PE file header.
+         */
+        [[nodiscard]] std::uint32_t timestamp( ) const noexcept
+        {
+            return m_timestamp;
+        }
+    };
+} // namespace odessa
\ No newline at end of file
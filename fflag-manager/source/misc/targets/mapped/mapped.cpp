@@ -0,0 +1,117 @@
+#include "mapped.hpp"
+
+namespace odessa
+{
+    void c_mapped_target::finalize( ) noexcept
+    {
+        const auto file_size = m_mapping.bytes( ).size( );
+
+        std::erase_if( m_ranges,
+                       [ & ]( const range_t &range )
+                       {
+                           return range.size == 0 or range.offset > file_size or range.length > file_size - range.offset;
+                       } );
+
+        std::ranges::sort( m_ranges, { }, &range_t::base );
+    }
+
+    const range_t *c_mapped_target::find( std::uint64_t address ) const noexcept
+    {
+        const auto it = std::ranges::upper_bound( m_ranges, address, { }, &range_t::base );
+        if ( it == m_ranges.begin( ) )
+            return nullptr;
+
+        const auto &range = *std::prev( it );
+        if ( address - range.base >= range.size )
+            return nullptr;
+
+        return &range;
+    }
+
+    bool c_mapped_target::valid( ) const noexcept
+    {
+        return static_cast< bool >( m_mapping ) and !m_ranges.empty( );
+    }
+
+    std::size_t c_mapped_target::read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept
+    {
+        auto       *output = static_cast< std::uint8_t * >( buffer );
+        std::size_t total { 0 };
+
+        while ( total < size )
+        {
+            const auto *range = find( address + total );
+            if ( !range or !range->readable )
+                break;
+
+            const auto delta = address + total - range->base;
+            const auto chunk = std::min< std::uint64_t >( size - total, range->size - delta );
+
+            // bytes past the end of the file backing are zero-filled, like .bss in a loaded image
+            const auto backed = delta < range->length ? std::min< std::uint64_t >( chunk, range->length - delta ) : 0;
+
+            if ( backed )
+                std::memcpy( output + total, m_mapping.bytes( ).data( ) + range->offset + delta, backed );
+
+            std::memset( output + total + backed, 0, chunk - backed );
+            total += chunk;
+        }
+
+        return total;
+    }
+
+    bool c_mapped_target::write( std::uint64_t, const void *, std::size_t ) const noexcept
+    {
+        return false;
+    }
+
+    std::optional< region_t > c_mapped_target::query( std::uint64_t address ) const noexcept
+    {
+        if ( const auto *range = find( address ) )
+        {
+            return region_t {
+                .base      = range->base,
+                .size      = range->size,
+                .committed = true,
+                .readable  = range->readable,
+                .writable  = range->writable,
+                .mapped    = std::ranges::any_of( m_modules,
+                                                  [ & ]( const module_t &mod )
+                                                  {
+                                                      return range->base - mod.base < mod.size;
+                                                  } ),
+            };
+        }
+
+        const auto next = std::ranges::upper_bound( m_ranges, address, { }, &range_t::base );
+        if ( next == m_ranges.end( ) )
+            return std::nullopt;
+
+        return region_t { .base = address, .size = next->base - address };
+    }
+
+    std::unique_ptr< module_t > c_mapped_target::module( const std::string &name ) const noexcept
+    {
+        for ( const auto &mod : m_modules )
+        {
+            if ( mod.name == name )
+                return std::make_unique< module_t >( mod );
+        }
+
+        return nullptr;
+    }
+
+    std::span< const std::uint8_t > c_mapped_target::view( std::uint64_t address, std::size_t size ) const noexcept
+    {
+        const auto *range = find( address );
+        if ( !range or !range->readable )
+            return { };
+
+        const auto delta = address - range->base;
+        if ( delta >= range->length )
+            return { };
+
+        const auto length = std::min< std::uint64_t >( size, range->length - delta );
+        return m_mapping.bytes( ).subspan( range->offset + delta, length );
+    }
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "mapping/mapping.hpp"
+#include "targets/target.hpp"
+
+namespace odessa
+{
+    struct range_t
+    {
+        std::uint64_t base { 0 };   ///< Virtual address the range is mapped to
+        std::uint64_t size { 0 };   ///< Virtual size of the range
+        std::uint64_t offset { 0 }; ///< File offset of the backing bytes
+        std::uint64_t length { 0 }; ///< Number of backing bytes in the file, the remainder reads as zero
+
+        bool readable { true };  ///< Whether the range can be read
+        bool writable { false }; ///< Whether the range was writable in the original process
+    };
+
+    class c_mapped_target : public c_target
+    {
+      protected:
+        c_mapping                m_mapping;   ///< Read-only mapping of the file
+        std::vector< range_t >   m_ranges;    ///< Virtual ranges backed by the file, sorted by base
+        std::vector< module_t >  m_modules;   ///< Modules described by the file
+
+        /**
+         * @brief Sorts the ranges and drops the ones whose backing bytes fall outside the file.
+         */
+        void finalize( ) noexcept;
+
+        /**
+         * @brief Finds the range containing an address.
+         *
+         * @param address The address to look up.
+         *
+         * @return A pointer to the range, or nullptr if the address is not mapped.
+         */
+        [[nodiscard]] const range_t *find( std::uint64_t address ) const noexcept;
+
+      public:
+        /**
+         * @brief Maps the file backing the target.
+         *
+         * @param path The path of the file to map.
+         */
+        c_mapped_target( const std::string &path ) noexcept : m_mapping( path ) { }
+
+        [[nodiscard]] bool valid( ) const noexcept override;
+
+        std::size_t read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept override;
+
+        /**
+         * @brief Offline targets are read-only, writes always fail.
+         */
+        bool write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept override;
+
+        [[nodiscard]] std::optional< region_t > query( std::uint64_t address ) const noexcept override;
+
+        [[nodiscard]] std::unique_ptr< module_t > module( const std::string &name ) const noexcept override;
+
+        [[nodiscard]] std::span< const std::uint8_t > view( std::uint64_t address, std::size_t size ) const noexcept override;
+    };
+} // namespace odessa
\ No newline at end of file
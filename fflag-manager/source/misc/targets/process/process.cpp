@@ -0,0 +1,190 @@
+#include "process.hpp"
+
+// standard
+#include <psapi.h>
+#include <tlhelp32.h>
+
+namespace odessa
+{
+    c_process_target::c_process_target( const std::string &name, std::chrono::milliseconds timeout ) noexcept
+    {
+        const auto started = std::chrono::steady_clock::now( );
+
+        while ( !m_process )
+        {
+            const auto snapshot = CreateToolhelp32Snapshot( TH32CS_SNAPPROCESS, 0 );
+            if ( snapshot == INVALID_HANDLE_VALUE )
+            {
+                if ( expired( started, timeout ) )
+                    break;
+
+                Sleep( 500 );
+                continue;
+            }
+
+            PROCESSENTRY32 proc { .dwSize = sizeof( PROCESSENTRY32 ) };
+
+            if ( Process32First( snapshot, &proc ) )
+            {
+                do
+                {
+                    if ( name == proc.szExeFile )
+                    {
+                        m_pid     = static_cast< std::int32_t >( proc.th32ProcessID );
+                        m_process = OpenProcess( PROCESS_ALL_ACCESS, FALSE, proc.th32ProcessID );
+                        break;
+                    }
+                } while ( Process32Next( snapshot, &proc ) );
+            }
+
+            CloseHandle( snapshot );
+
+            if ( m_process or expired( started, timeout ) )
+                break;
+
+            Sleep( 500 );
+        }
+    }
+
+    c_process_target::~c_process_target( ) noexcept
+    {
+        if ( m_process )
+        {
+            CloseHandle( m_process );
+            m_process = nullptr;
+        }
+
+        m_pid = 0;
+    }
+
+    bool c_process_target::valid( ) const noexcept
+    {
+        return m_process != nullptr;
+    }
+
+    std::size_t c_process_target::read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept
+    {
+        std::size_t bytes_read { 0 };
+
+        if ( !ReadProcessMemory( m_process, reinterpret_cast< void * >( address ), buffer, size, &bytes_read ) )
+            return 0;
+
+        return bytes_read;
+    }
+
+    bool c_process_target::write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept
+    {
+        return WriteProcessMemory( m_process, reinterpret_cast< void * >( address ), buffer, size, nullptr ) != 0;
+    }
+
+    std::optional< region_t > c_process_target::query( std::uint64_t address ) const noexcept
+    {
+        MEMORY_BASIC_INFORMATION mbi { };
+
+        if ( VirtualQueryEx( m_process, reinterpret_cast< void * >( address ), &mbi, sizeof( mbi ) ) != sizeof( mbi ) )
+            return region_t { .base = address, .size = 0x1000 };
+
+        const bool committed = mbi.State == MEM_COMMIT;
+
+        return region_t {
+            .base      = reinterpret_cast< std::uint64_t >( mbi.BaseAddress ),
+            .size      = mbi.RegionSize,
+            .committed = committed,
+            .readable  = committed
+                     and ( ( mbi.Protect & PAGE_READONLY ) or ( mbi.Protect & PAGE_READWRITE ) or ( mbi.Protect & PAGE_WRITECOPY )
+                           or ( mbi.Protect & PAGE_EXECUTE_READ ) or ( mbi.Protect & PAGE_EXECUTE_READWRITE ) ),
+            .writable = committed and ( ( mbi.Protect & PAGE_READWRITE ) or ( mbi.Protect & PAGE_EXECUTE_READWRITE ) ),
+            .mapped   = committed and mbi.Type != MEM_PRIVATE,
+        };
+    }
+
+    std::unique_ptr< module_t > c_process_target::module( const std::string &name ) const noexcept
+    {
+        if ( !m_process or m_pid == 0 )
+            return nullptr;
+
+        const auto snapshot = CreateToolhelp32Snapshot( TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, m_pid );
+        if ( snapshot == INVALID_HANDLE_VALUE )
+            return nullptr;
+
+        MODULEENTRY32 mod { .dwSize = sizeof( MODULEENTRY32 ) };
+
+        std::unique_ptr< module_t > result;
+
+        if ( Module32First( snapshot, &mod ) )
+        {
+            do
+            {
+                if ( name == mod.szModule )
+                {
+                    result = std::make_unique< module_t >( );
+
+                    result->base = reinterpret_cast< std::uint64_t >( mod.modBaseAddr );
+                    result->size = mod.modBaseSize;
+                    result->name = mod.szModule;
+                    result->path = mod.szExePath;
+                    break;
+                }
+            } while ( Module32Next( snapshot, &mod ) );
+        }
+
+        CloseHandle( snapshot );
+        return result;
+    }
+
+    bool c_process_target::wait( std::chrono::milliseconds timeout ) const noexcept
+    {
+        const auto started = std::chrono::steady_clock::now( );
+
+        // cant be asked to add an actual check to see if roblox is open sry
+        while ( !FindWindowA( nullptr, "Roblox" ) )
+        {
+            if ( expired( started, timeout ) )
+                return false;
+
+            Sleep( 300 );
+        }
+
+        return true;
+    }
+
+    void c_process_target::join( ) const noexcept
+    {
+        if ( m_process )
+            WaitForSingleObject( m_process, INFINITE );
+    }
+
+    std::vector< bool > c_process_target::residency( std::uint64_t address, std::size_t size ) const noexcept
+    {
+        std::vector< PSAPI_WORKING_SET_EX_INFORMATION > pages( ( size + page_size - 1 ) / page_size );
+
+        for ( std::size_t idx = 0; idx < pages.size( ); ++idx )
+            pages[ idx ].VirtualAddress = reinterpret_cast< PVOID >( address + idx * page_size );
+
+        const auto bytes = static_cast< DWORD >( pages.size( ) * sizeof( PSAPI_WORKING_SET_EX_INFORMATION ) );
+        if ( !QueryWorkingSetEx( m_process, pages.data( ), bytes ) )
+            return { };
+
+        std::vector< bool > resident( pages.size( ) );
+
+        for ( std::size_t idx = 0; idx < pages.size( ); ++idx )
+            resident[ idx ] = pages[ idx ].VirtualAttributes.Valid;
+
+        return resident;
+    }
+
+    std::optional< footprint_t > c_process_target::footprint( ) const noexcept
+    {
+        PROCESS_MEMORY_COUNTERS counters { .cb = sizeof( PROCESS_MEMORY_COUNTERS ) };
+
+        if ( !GetProcessMemoryInfo( m_process, &counters, sizeof( counters ) ) )
+            return std::nullopt;
+
+        return footprint_t { .faults = counters.PageFaultCount, .working_set = counters.WorkingSetSize };
+    }
+
+    bool c_process_target::alive( ) const noexcept
+    {
+        return m_process and WaitForSingleObject( m_process, 0 ) == WAIT_TIMEOUT;
+    }
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "targets/target.hpp"
+
+namespace odessa
+{
+    class c_process_target : public c_target
+    {
+        HANDLE       m_process { nullptr }; ///< Handle to the target process
+        std::int32_t m_pid { 0 };           ///< Process ID of the target process
+
+      public:
+        /**
+         * @brief Waits for a process with the given name and opens it.
+         *
+         * @param name The executable name of the process to open.
+         * @param timeout How long to wait for the process, the target is invalid if it did not appear in time.
+         */
+        c_process_target( const std::string &name, std::chrono::milliseconds timeout = forever ) noexcept;
+
+        /**
+         * @brief Closes the process handle.
+         */
+        ~c_process_target( ) noexcept override;
+
+        [[nodiscard]] bool valid( ) const noexcept override;
+
+        std::size_t read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept override;
+
+        bool write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept override;
+
+        [[nodiscard]] std::optional< region_t > query( std::uint64_t address ) const noexcept override;
+
+        [[nodiscard]] std::unique_ptr< module_t > module( const std::string &name ) const noexcept override;
+
+        /**
+         * @brief Blocks until the client has created its main window.
+         */
+        bool wait( std::chrono::milliseconds timeout = forever ) const noexcept override;
+
+        /**
+         * @brief Waits on the process handle until the client exits.
+         */
+        void join( ) const noexcept override;
+
+        /**
+         * @brief Queries the range with QueryWorkingSetEx.
+         */
+        [[nodiscard]] std::vector< bool > residency( std::uint64_t address, std::size_t size ) const noexcept override;
+
+        /**
+         * @brief Queries the counters with GetProcessMemoryInfo.
+         */
+        [[nodiscard]] std::optional< footprint_t > footprint( ) const noexcept override;
+
+        /**
+         * @brief Polls the process handle.
+         */
+        [[nodiscard]] bool alive( ) const noexcept override;
+
+        [[nodiscard]] std::int32_t pid( ) const noexcept override
+        {
+            return m_pid;
+        }
+
+        /**
+         * @brief Returns the process handle associated with the object.
+         *
+         * @return The HANDLE representing the process.
+         */
+        [[nodiscard]] HANDLE handle( ) const noexcept
+        {
+            return m_process;
+        }
+    };
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "native.hpp"
+
+namespace odessa
+{
+    struct module_t
+    {
+        std::uint64_t base { 0 }; ///< Base address of the module
+        std::uint32_t size { 0 }; ///< Size of the module in bytes
+
+        std::string name { "" }; ///< Name of the module
+        std::string path { "" }; ///< Full path to the module
+    };
+
+    struct build_t
+    {
+        std::uint32_t timestamp { 0 }; ///< Link timestamp from the PE file header
+        std::uint32_t size { 0 };      ///< SizeOfImage from the PE optional header
+
+        /**
+         * @brief Checks whether the build could be identified.
+         *
+         * @return True if the headers were read, false otherwise.
+         */
+        [[nodiscard]] bool valid( ) const noexcept
+        {
+            return timestamp != 0 and size != 0;
+        }
+
+        bool operator==( const build_t & ) const noexcept = default;
+    };
+
+    struct region_t
+    {
+        std::uint64_t base { 0 }; ///< Base address of the region
+        std::uint64_t size { 0 }; ///< Size of the region in bytes
+
+        bool committed { false }; ///< Whether the region is backed by memory
+        bool readable { false };  ///< Whether the region can be read
+        bool writable { false };  ///< Whether the region can be written
+        bool mapped { false };    ///< Whether the region is backed by an image or file rather than private memory
+    };
+
+    struct footprint_t
+    {
+        std::uint64_t faults { 0 };      ///< Page faults the process has taken since it started
+        std::uint64_t working_set { 0 }; ///< Bytes of the process resident in physical memory
+    };
+
+    struct read_request_t
+    {
+        std::uint64_t address { 0 }; ///< Address to read from
+        void         *buffer { nullptr }; ///< Destination buffer
+        std::size_t   size { 0 };    ///< Number of bytes to read
+        std::size_t   result { 0 };  ///< Number of bytes actually read, filled in by the backend
+    };
+
+    struct write_request_t
+    {
+        std::uint64_t address { 0 };      ///< Address to write to
+        const void   *buffer { nullptr }; ///< Source buffer
+        std::size_t   size { 0 };         ///< Number of bytes to write
+        bool          written { false };  ///< Whether every byte was written, filled in by the backend
+    };
+
+    class c_target
+    {
+      public:
+        static constexpr std::uint64_t             page_size { 0x1000 };                     ///< Granularity of residency()
+        static constexpr std::chrono::milliseconds forever { std::chrono::milliseconds::max( ) }; ///< Timeout of waits that never give up
+
+        /**
+         * @brief Checks whether a wait has run out of time.
+         *
+         * @param started When the wait began.
+         * @param timeout How long the wait may take, forever to never run out.
+         *
+         * @return True if the timeout has elapsed, false otherwise.
+         */
+        [[nodiscard]] static bool expired( std::chrono::steady_clock::time_point started, std::chrono::milliseconds timeout ) noexcept
+        {
+            return timeout != forever and std::chrono::steady_clock::now( ) - started >= timeout;
+        }
+
+        /**
+         * @brief Destroys the target and releases any associated resources.
+         */
+        virtual ~c_target( ) noexcept = default;
+
+        /**
+         * @brief Checks whether the target was opened successfully.
+         *
+         * @return True if the target can be inspected, false otherwise.
+         */
+        [[nodiscard]] virtual bool valid( ) const noexcept = 0;
+
+        /**
+         * @brief Reads raw bytes from the target.
+         *
+         * @param address The address to read from.
+         * @param buffer The destination buffer.
+         * @param size The number of bytes to read.
+         *
+         * @return The number of bytes actually read.
+         */
+        virtual std::size_t read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept = 0;
+
+        /**
+         * @brief Reads a batch of ranges from the target.
+         *
+         * Backends with a scatter/gather interface override this to issue the whole batch at once.
+         *
+         * @param requests The ranges to read. Each request's result is filled in.
+         */
+        virtual void read_batch( std::span< read_request_t > requests ) const noexcept
+        {
+            for ( auto &request : requests )
+                request.result = read( request.address, request.buffer, request.size );
+        }
+
+        /**
+         * @brief Writes raw bytes to the target.
+         *
+         * @param address The address to write to.
+         * @param buffer The source buffer.
+         * @param size The number of bytes to write.
+         *
+         * @return True if every byte was written, false otherwise.
+         */
+        virtual bool write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept = 0;
+
+        /**
+         * @brief Writes a batch of ranges to the target.
+         *
+         * Backends with a scatter/gather interface override this to issue the whole batch at once.
+         *
+         * @param requests The ranges to write. Each request's written flag is filled in.
+         */
+        virtual void write_batch( std::span< write_request_t > requests ) const noexcept
+        {
+            for ( auto &request : requests )
+                request.written = write( request.address, request.buffer, request.size );
+        }
+
+        /**
+         * @brief Describes the region containing the given address.
+         *
+         * If the address lies in a gap, the returned region is uncommitted and spans up to the next region.
+         *
+         * @param address The address to query.
+         *
+         * @return The region, or std::nullopt if nothing exists at or after the address.
+         */
+        [[nodiscard]] virtual std::optional< region_t > query( std::uint64_t address ) const noexcept = 0;
+
+        /**
+         * @brief Looks up a loaded module by name.
+         *
+         * @param name The name of the module to retrieve.
+         *
+         * @return A std::unique_ptr to the module, or nullptr if the module is not found.
+         */
+        [[nodiscard]] virtual std::unique_ptr< module_t > module( const std::string &name ) const noexcept = 0;
+
+        /**
+         * @brief Returns a zero-copy view of target memory, if the backend can provide one.
+         *
+         * @param address The address of the view.
+         * @param size The size of the view in bytes.
+         *
+         * @return A span over the bytes, or an empty span if the range is not directly addressable.
+         */
+        [[nodiscard]] virtual std::span< const std::uint8_t > view( std::uint64_t address, std::size_t size ) const noexcept
+        {
+            return { };
+        }
+
+        /**
+         * @brief Checks which pages of a range are in the target's working set, i.e. can be read without faulting them in.
+         *
+         * @param address The page aligned start of the range.
+         * @param size The size of the range in bytes.
+         *
+         * @return One flag per page, or an empty vector if the backend cannot tell, in which case every page counts as
+         *         resident. Offline targets cannot tell.
+         */
+        [[nodiscard]] virtual std::vector< bool > residency( std::uint64_t address, std::size_t size ) const noexcept
+        {
+            return { };
+        }
+
+        /**
+         * @brief Reads the page fault count and working set size of the target process.
+         *
+         * @return The counters, or std::nullopt for offline targets or if they could not be queried.
+         */
+        [[nodiscard]] virtual std::optional< footprint_t > footprint( ) const noexcept
+        {
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Blocks until the target is ready to be inspected. Offline targets are always ready.
+         *
+         * @param timeout How long to wait at most.
+         *
+         * @return True if the target is ready, false if the timeout elapsed first.
+         */
+        virtual bool wait( std::chrono::milliseconds timeout = forever ) const noexcept
+        {
+            return true;
+        }
+
+        /**
+         * @brief Blocks until the target process has exited. Offline targets return immediately.
+         */
+        virtual void join( ) const noexcept { }
+
+        /**
+         * @brief Attaches a named value to a recording of the target. Targets that are not recorded ignore it.
+         *
+         * @param key The name of the value.
+         * @param value The value.
+         */
+        virtual void note( std::string_view key, std::uint64_t value ) const noexcept { }
+
+        /**
+         * @brief Re-reads the address space layout, for backends that answer query() and module() from a snapshot.
+         */
+        virtual void refresh( ) const noexcept { }
+
+        /**
+         * @brief Checks whether the target process is still running without blocking. Offline targets never are.
+         *
+         * @return True if the process is running, false otherwise.
+         */
+        [[nodiscard]] virtual bool alive( ) const noexcept
+        {
+            return false;
+        }
+
+        /**
+         * @brief Returns the process identifier of the target.
+         *
+         * @return The process identifier, or 0 for offline targets.
+         */
+        [[nodiscard]] virtual std::int32_t pid( ) const noexcept
+        {
+            return 0;
+        }
+    };
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,608 @@
+#include "trace.hpp"
+
+namespace odessa
+{
+    struct trace_reader_t
+    {
+        std::span< const std::uint8_t > data { }; ///< Bytes of the trace
+        std::size_t                     offset { 0 }; ///< Read position
+        bool                            ok { true };  ///< Cleared once a read runs past the end
+
+        std::uint64_t varint( ) noexcept
+        {
+            std::uint64_t value { 0 };
+
+            for ( std::uint32_t shift = 0; shift < 64; shift += 7 )
+            {
+                if ( offset >= data.size( ) )
+                {
+                    ok = false;
+                    return 0;
+                }
+
+                const auto byte = data[ offset++ ];
+                value |= static_cast< std::uint64_t >( byte & 0x7f ) << shift;
+
+                if ( !( byte & 0x80 ) )
+                    return value;
+            }
+
+            ok = false;
+            return 0;
+        }
+
+        std::span< const std::uint8_t > take( std::uint64_t size ) noexcept
+        {
+            if ( size > data.size( ) - offset )
+            {
+                ok = false;
+                return { };
+            }
+
+            const auto result = data.subspan( offset, size );
+            offset += size;
+            return result;
+        }
+
+        std::uint8_t byte( ) noexcept
+        {
+            const auto result = take( 1 );
+            return result.empty( ) ? 0 : result[ 0 ];
+        }
+    };
+
+    c_recording_target::c_recording_target( std::unique_ptr< c_target > target, const std::string &path ) noexcept :
+        m_target( std::move( target ) ), m_file( path, std::ios::binary | std::ios::trunc ), m_start( std::chrono::steady_clock::now( ) )
+    {
+        bytes( &trace::magic, sizeof( trace::magic ) );
+        bytes( &trace::version, sizeof( trace::version ) );
+        varint( static_cast< std::uint32_t >( m_target->pid( ) ) );
+        commit( true );
+    }
+
+    c_recording_target::~c_recording_target( ) noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+        commit( true );
+    }
+
+    void c_recording_target::varint( std::uint64_t value ) const noexcept
+    {
+        while ( value >= 0x80 )
+        {
+            m_buffer.push_back( static_cast< std::uint8_t >( value | 0x80 ) );
+            value >>= 7;
+        }
+
+        m_buffer.push_back( static_cast< std::uint8_t >( value ) );
+    }
+
+    void c_recording_target::bytes( const void *data, std::size_t size ) const noexcept
+    {
+        const auto *begin = static_cast< const std::uint8_t * >( data );
+        m_buffer.insert( m_buffer.end( ), begin, begin + size );
+    }
+
+    void c_recording_target::begin( e_trace_op op, std::chrono::steady_clock::time_point start,
+                                    std::chrono::steady_clock::time_point end ) const noexcept
+    {
+        m_buffer.push_back( static_cast< std::uint8_t >( op ) );
+
+        varint( static_cast< std::uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( start - m_start ).count( ) ) );
+        varint( static_cast< std::uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >( end - start ).count( ) ) );
+    }
+
+    void c_recording_target::commit( bool force ) const noexcept
+    {
+        if ( m_buffer.empty( ) or ( !force and m_buffer.size( ) < 0x10000 ) )
+            return;
+
+        m_file.write( reinterpret_cast< const char * >( m_buffer.data( ) ), static_cast< std::streamsize >( m_buffer.size( ) ) );
+        m_file.flush( );
+        m_buffer.clear( );
+    }
+
+    bool c_recording_target::valid( ) const noexcept
+    {
+        return m_target->valid( ) and m_file.is_open( );
+    }
+
+    std::size_t c_recording_target::read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept
+    {
+        const auto start  = std::chrono::steady_clock::now( );
+        const auto result = m_target->read( address, buffer, size );
+        const auto end    = std::chrono::steady_clock::now( );
+
+        std::scoped_lock lock( m_mutex );
+
+        begin( e_trace_op::read, start, end );
+        varint( address );
+        varint( size );
+        varint( result );
+        bytes( buffer, result );
+        commit( );
+
+        return result;
+    }
+
+    void c_recording_target::read_batch( std::span< read_request_t > requests ) const noexcept
+    {
+        const auto start = std::chrono::steady_clock::now( );
+        m_target->read_batch( requests );
+        const auto end = std::chrono::steady_clock::now( );
+
+        std::scoped_lock lock( m_mutex );
+
+        begin( e_trace_op::batch, start, end );
+        varint( requests.size( ) );
+
+        for ( const auto &request : requests )
+        {
+            varint( request.address );
+            varint( request.size );
+            varint( request.result );
+            bytes( request.buffer, request.result );
+        }
+
+        commit( );
+    }
+
+    bool c_recording_target::write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept
+    {
+        const auto start   = std::chrono::steady_clock::now( );
+        const auto written = m_target->write( address, buffer, size );
+        const auto end     = std::chrono::steady_clock::now( );
+
+        std::scoped_lock lock( m_mutex );
+
+        begin( e_trace_op::write, start, end );
+        varint( address );
+        varint( size );
+        m_buffer.push_back( written ? 1 : 0 );
+        bytes( buffer, size );
+        commit( );
+
+        return written;
+    }
+
+    std::optional< region_t > c_recording_target::query( std::uint64_t address ) const noexcept
+    {
+        const auto start  = std::chrono::steady_clock::now( );
+        const auto region = m_target->query( address );
+        const auto end    = std::chrono::steady_clock::now( );
+
+        std::scoped_lock lock( m_mutex );
+
+        begin( e_trace_op::query, start, end );
+        varint( address );
+        m_buffer.push_back( region ? 1 : 0 );
+
+        if ( region )
+        {
+            varint( region->base );
+            varint( region->size );
+            m_buffer.push_back( static_cast< std::uint8_t >( region->committed | region->readable << 1 | region->writable << 2 | region->mapped << 3 ) );
+        }
+
+        commit( );
+
+        return region;
+    }
+
+    std::unique_ptr< module_t > c_recording_target::module( const std::string &name ) const noexcept
+    {
+        const auto start  = std::chrono::steady_clock::now( );
+        auto       result = m_target->module( name );
+        const auto end    = std::chrono::steady_clock::now( );
+
+        std::scoped_lock lock( m_mutex );
+
+        begin( e_trace_op::module, start, end );
+        varint( name.size( ) );
+        bytes( name.data( ), name.size( ) );
+        m_buffer.push_back( result ? 1 : 0 );
+
+        if ( result )
+        {
+            varint( result->base );
+            varint( result->size );
+            varint( result->path.size( ) );
+            bytes( result->path.data( ), result->path.size( ) );
+        }
+
+        commit( );
+
+        return result;
+    }
+
+    void c_recording_target::note( std::string_view key, std::uint64_t value ) const noexcept
+    {
+        const auto now = std::chrono::steady_clock::now( );
+
+        std::scoped_lock lock( m_mutex );
+
+        begin( e_trace_op::note, now, now );
+        varint( key.size( ) );
+        bytes( key.data( ), key.size( ) );
+        varint( value );
+        commit( );
+    }
+
+    c_replay_target::c_replay_target( const std::string &path, bool realtime ) noexcept : m_mapping( path ), m_realtime( realtime )
+    {
+        if ( m_mapping and !parse( ) )
+            m_records.clear( );
+
+        m_clock = std::chrono::steady_clock::now( );
+    }
+
+    bool c_replay_target::parse( ) noexcept
+    {
+        const auto *header = m_mapping.at< std::uint32_t >( 0, 2 );
+        if ( !header or header[ 0 ] != trace::magic or header[ 1 ] != trace::version )
+            return false;
+
+        trace_reader_t reader { .data = m_mapping.bytes( ), .offset = sizeof( std::uint32_t ) * 2 };
+
+        m_pid = static_cast< std::int32_t >( reader.varint( ) );
+
+        std::array< std::uint64_t, trace::op_count > totals { };
+        std::array< std::uint64_t, trace::op_count > counts { };
+
+        const auto read_entry = [ & ]( record_t &record )
+        {
+            record.address = reader.varint( );
+            record.size    = reader.varint( );
+            record.result  = std::min( reader.varint( ), record.size );
+            record.bytes   = reader.take( record.result );
+        };
+
+        while ( reader.ok and reader.offset < reader.data.size( ) )
+        {
+            record_t record { .op = static_cast< e_trace_op >( reader.byte( ) ) };
+
+            record.start    = reader.varint( );
+            record.duration = reader.varint( );
+
+            switch ( record.op )
+            {
+                case e_trace_op::read :
+                {
+                    read_entry( record );
+                    break;
+                }
+                case e_trace_op::batch :
+                {
+                    const auto count = reader.varint( );
+
+                    for ( std::uint64_t idx = 0; idx < count and reader.ok; ++idx )
+                        read_entry( record.entries.emplace_back( ) );
+
+                    break;
+                }
+                case e_trace_op::write :
+                {
+                    record.address = reader.varint( );
+                    record.size    = reader.varint( );
+                    record.result  = reader.byte( );
+                    record.bytes   = reader.take( record.size );
+                    break;
+                }
+                case e_trace_op::query :
+                {
+                    record.address = reader.varint( );
+
+                    if ( reader.byte( ) )
+                    {
+                        region_t region { .base = reader.varint( ) };
+
+                        region.size = reader.varint( );
+
+                        const auto flags = reader.byte( );
+
+                        region.committed = flags & 1;
+                        region.readable  = flags & 2;
+                        region.writable  = flags & 4;
+                        region.mapped    = flags & 8;
+
+                        record.region = region;
+                    }
+
+                    break;
+                }
+                case e_trace_op::module :
+                {
+                    const auto name = reader.take( reader.varint( ) );
+                    record.name.assign( name.begin( ), name.end( ) );
+
+                    if ( reader.byte( ) )
+                    {
+                        module_t mod { .base = reader.varint( ), .name = record.name };
+
+                        mod.size = static_cast< std::uint32_t >( reader.varint( ) );
+
+                        const auto module_path = reader.take( reader.varint( ) );
+                        mod.path.assign( module_path.begin( ), module_path.end( ) );
+
+                        record.module = std::move( mod );
+                    }
+
+                    break;
+                }
+                case e_trace_op::note :
+                {
+                    const auto key   = reader.take( reader.varint( ) );
+                    const auto value = reader.varint( );
+
+                    if ( reader.ok )
+                        m_notes[ std::string( key.begin( ), key.end( ) ) ] = value;
+
+                    continue;
+                }
+                default :
+                    reader.ok = false;
+            }
+
+            if ( !reader.ok )
+                break;
+
+            const auto op = static_cast< std::size_t >( record.op );
+
+            totals[ op ] += record.duration;
+            ++counts[ op ];
+
+            m_records.push_back( std::move( record ) );
+        }
+
+        for ( std::size_t op = 0; op < m_average.size( ); ++op )
+            m_average[ op ] = counts[ op ] ? totals[ op ] / counts[ op ] : 0;
+
+        // the image ends up holding the last bytes seen at every address, which diverged calls are served from
+        for ( const auto &record : m_records )
+        {
+            switch ( record.op )
+            {
+                case e_trace_op::read :
+                    store( record.address, record.bytes );
+                    break;
+                case e_trace_op::batch :
+                    for ( const auto &entry : record.entries )
+                        store( entry.address, entry.bytes );
+                    break;
+                case e_trace_op::write :
+                    if ( record.result )
+                        store( record.address, record.bytes );
+                    break;
+                case e_trace_op::query :
+                    if ( record.region )
+                        m_regions[ record.region->base ] = *record.region;
+                    break;
+                case e_trace_op::module :
+                    if ( record.module )
+                        m_modules[ record.name ] = *record.module;
+                    break;
+                default :
+                    break;
+            }
+        }
+
+        return true;
+    }
+
+    void c_replay_target::store( std::uint64_t address, std::span< const std::uint8_t > bytes ) const noexcept
+    {
+        for ( std::size_t idx = 0; idx < bytes.size( ); )
+        {
+            const auto current = address + idx;
+            const auto offset  = current % page_size;
+            const auto count   = std::min< std::size_t >( page_size - offset, bytes.size( ) - idx );
+
+            const auto [ it, inserted ] = m_image.try_emplace( current - offset );
+            if ( inserted )
+                m_pages.insert( current - offset );
+
+            auto &page = it->second;
+
+            std::memcpy( page.bytes.data( ) + offset, bytes.data( ) + idx, count );
+
+            for ( std::size_t bit = 0; bit < count; ++bit )
+                page.known.set( offset + bit );
+
+            idx += count;
+        }
+    }
+
+    std::size_t c_replay_target::load( std::uint64_t address, void *buffer, std::size_t size ) const noexcept
+    {
+        auto *destination = static_cast< std::uint8_t * >( buffer );
+
+        for ( std::size_t idx = 0; idx < size; ++idx )
+        {
+            const auto current = address + idx;
+            const auto it      = m_image.find( current - current % page_size );
+
+            if ( it == m_image.end( ) or !it->second.known.test( current % page_size ) )
+                return idx;
+
+            destination[ idx ] = it->second.bytes[ current % page_size ];
+        }
+
+        return size;
+    }
+
+    const c_replay_target::record_t *c_replay_target::next( const std::function< bool( const record_t & ) > &predicate ) const noexcept
+    {
+        const auto end = std::min( m_records.size( ), m_cursor + trace::window );
+
+        for ( auto idx = m_cursor; idx < end; ++idx )
+        {
+            if ( !predicate( m_records[ idx ] ) )
+                continue;
+
+            m_cursor = idx + 1;
+            ++m_stats.matched;
+            return &m_records[ idx ];
+        }
+
+        ++m_stats.diverged;
+        return nullptr;
+    }
+
+    void c_replay_target::pace( e_trace_op op, const record_t *record ) const noexcept
+    {
+        if ( !m_realtime )
+            return;
+
+        if ( record )
+            m_position = std::max( m_position, record->start + record->duration );
+        else
+            m_debt += m_average[ static_cast< std::size_t >( op ) ];
+
+        std::this_thread::sleep_until( m_clock + std::chrono::nanoseconds( m_position + m_debt ) );
+    }
+
+    bool c_replay_target::valid( ) const noexcept
+    {
+        return !m_records.empty( );
+    }
+
+    std::size_t c_replay_target::read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        const auto *record = next(
+            [ & ]( const record_t &candidate )
+            {
+                return candidate.op == e_trace_op::read and candidate.address == address and candidate.size == size;
+            } );
+
+        pace( e_trace_op::read, record );
+
+        if ( !record )
+            return load( address, buffer, size );
+
+        std::memcpy( buffer, record->bytes.data( ), record->bytes.size( ) );
+        return record->result;
+    }
+
+    void c_replay_target::read_batch( std::span< read_request_t > requests ) const noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        const auto *record = next(
+            [ & ]( const record_t &candidate )
+            {
+                if ( candidate.op != e_trace_op::batch or candidate.entries.size( ) != requests.size( ) )
+                    return false;
+
+                for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+                {
+                    if ( candidate.entries[ idx ].address != requests[ idx ].address or candidate.entries[ idx ].size != requests[ idx ].size )
+                        return false;
+                }
+
+                return true;
+            } );
+
+        pace( e_trace_op::batch, record );
+
+        for ( std::size_t idx = 0; idx < requests.size( ); ++idx )
+        {
+            auto &request = requests[ idx ];
+
+            if ( !record )
+            {
+                request.result = load( request.address, request.buffer, request.size );
+                continue;
+            }
+
+            const auto &entry = record->entries[ idx ];
+
+            std::memcpy( request.buffer, entry.bytes.data( ), entry.bytes.size( ) );
+            request.result = entry.result;
+        }
+    }
+
+    bool c_replay_target::write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        const auto *record = next(
+            [ & ]( const record_t &candidate )
+            {
+                return candidate.op == e_trace_op::write and candidate.address == address and candidate.size == size;
+            } );
+
+        pace( e_trace_op::write, record );
+
+        if ( record )
+            return record->result != 0;
+
+        store( address, { static_cast< const std::uint8_t * >( buffer ), size } );
+        return true;
+    }
+
+    std::optional< region_t > c_replay_target::query( std::uint64_t address ) const noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        const auto *record = next(
+            [ & ]( const record_t &candidate )
+            {
+                return candidate.op == e_trace_op::query and candidate.address == address;
+            } );
+
+        pace( e_trace_op::query, record );
+
+        if ( record )
+            return record->region;
+
+        if ( const auto it = m_regions.upper_bound( address ); it != m_regions.begin( ) )
+        {
+            const auto &region = std::prev( it )->second;
+
+            if ( address - region.base < region.size )
+                return region;
+        }
+
+        const auto page = address - address % page_size;
+
+        if ( m_image.contains( page ) )
+            return region_t { .base = page, .size = page_size, .committed = true, .readable = true };
+
+        // unknown memory reaches up to the next region or page the trace knows, so walks over the address space stay short
+        std::optional< std::uint64_t > next;
+
+        if ( const auto it = m_regions.upper_bound( address ); it != m_regions.end( ) )
+            next = it->first;
+
+        if ( const auto it = m_pages.upper_bound( page ); it != m_pages.end( ) )
+            next = std::min( next.value_or( *it ), *it );
+
+        if ( !next )
+            return std::nullopt;
+
+        return region_t { .base = address, .size = *next - address };
+    }
+
+    std::unique_ptr< module_t > c_replay_target::module( const std::string &name ) const noexcept
+    {
+        std::scoped_lock lock( m_mutex );
+
+        const auto *record = next(
+            [ & ]( const record_t &candidate )
+            {
+                return candidate.op == e_trace_op::module and candidate.name == name;
+            } );
+
+        pace( e_trace_op::module, record );
+
+        if ( record )
+            return record->module ? std::make_unique< module_t >( *record->module ) : nullptr;
+
+        if ( const auto it = m_modules.find( name ); it != m_modules.end( ) )
+            return std::make_unique< module_t >( it->second );
+
+        return nullptr;
+    }
+} // namespace odessa
\ No newline at end of file
@@ -0,0 +1,290 @@
+#pragma once
+
+#include "native.hpp"
+
+// local->misc
+#include "mapping/mapping.hpp"
+#include "targets/target.hpp"
+
+namespace odessa
+{
+    enum class e_trace_op : std::uint8_t
+    {
+        read   = 1, ///< c_target::read
+        batch  = 2, ///< c_target::read_batch
+        write  = 3, ///< c_target::write
+        query  = 4, ///< c_target::query
+        module = 5, ///< c_target::module
+        note   = 6  ///< Named value attached by the caller, not a target call
+    };
+
+    namespace trace
+    {
+        constexpr std::uint32_t magic { 0x5254444f }; ///< "ODTR"
+        constexpr std::uint32_t version { 2 };        ///< Bumped whenever the record layout changes
+
+        constexpr std::size_t window { 256 }; ///< Records a diverged replay looks ahead to find its place again
+        constexpr std::size_t op_count { 7 }; ///< Size of tables indexed by e_trace_op
+    } // namespace trace
+
+    struct replay_stats_t
+    {
+        std::uint64_t matched { 0 };  ///< Calls served from the record at the replay position
+        std::uint64_t diverged { 0 }; ///< Calls that did not match the trace and were served from the memory image
+    };
+
+    class c_recording_target : public c_target
+    {
+        std::unique_ptr< c_target > m_target { nullptr }; ///< Backend the calls are forwarded to
+
+        mutable std::mutex                  m_mutex { };  ///< Serializes records
+        mutable std::ofstream               m_file { };   ///< Trace file
+        mutable std::vector< std::uint8_t > m_buffer { }; ///< Encoded records not yet written to the file
+
+        std::chrono::steady_clock::time_point m_start { }; ///< Time the recording started
+
+        /**
+         * @brief Appends an unsigned LEB128 varint to the buffer.
+         */
+        void varint( std::uint64_t value ) const noexcept;
+
+        /**
+         * @brief Appends raw bytes to the buffer.
+         */
+        void bytes( const void *data, std::size_t size ) const noexcept;
+
+        /**
+         * @brief Appends a record header: the op, its start relative to the recording and its duration in nanoseconds.
+         */
+        void begin( e_trace_op op, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end ) const noexcept;
+
+        /**
+         * @brief Writes the buffer to the file once it has grown large enough, or unconditionally when forced.
+         */
+        void commit( bool force = false ) const noexcept;
+
+      public:
+        /**
+         * @brief Wraps a backend and records every read, write, query and module lookup issued through it.
+         *
+         * @param target The backend to record.
+         * @param path The path of the trace file to create.
+         */
+        c_recording_target( std::unique_ptr< c_target > target, const std::string &path ) noexcept;
+
+        /**
+         * @brief Writes any buffered records to the trace file.
+         */
+        ~c_recording_target( ) noexcept override;
+
+        [[nodiscard]] bool valid( ) const noexcept override;
+
+        std::size_t read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept override;
+
+        void read_batch( std::span< read_request_t > requests ) const noexcept override;
+
+        bool write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept override;
+
+        [[nodiscard]] std::optional< region_t > query( std::uint64_t address ) const noexcept override;
+
+        [[nodiscard]] std::unique_ptr< module_t > module( const std::string &name ) const noexcept override;
+
+        /**
+         * @brief Attaches a named value to the trace, e.g. the singleton offset the session resolved.
+         *
+         * @param key The name of the value.
+         * @param value The value.
+         */
+        void note( std::string_view key, std::uint64_t value ) const noexcept override;
+
+        /**
+         * @brief Never hands out views, so scans go through read() and end up in the trace.
+         */
+        [[nodiscard]] std::span< const std::uint8_t > view( std::uint64_t address, std::size_t size ) const noexcept override
+        {
+            return { };
+        }
+
+        /**
+         * @brief Not recorded, a replay reads every page as if it were resident.
+         */
+        [[nodiscard]] std::vector< bool > residency( std::uint64_t address, std::size_t size ) const noexcept override
+        {
+            return m_target->residency( address, size );
+        }
+
+        /**
+         * @brief Not recorded, a replay has no process to measure.
+         */
+        [[nodiscard]] std::optional< footprint_t > footprint( ) const noexcept override
+        {
+            return m_target->footprint( );
+        }
+
+        bool wait( std::chrono::milliseconds timeout = forever ) const noexcept override
+        {
+            return m_target->wait( timeout );
+        }
+
+        void join( ) const noexcept override
+        {
+            m_target->join( );
+        }
+
+        void refresh( ) const noexcept override
+        {
+            m_target->refresh( );
+        }
+
+        [[nodiscard]] bool alive( ) const noexcept override
+        {
+            return m_target->alive( );
+        }
+
+        [[nodiscard]] std::int32_t pid( ) const noexcept override
+        {
+            return m_target->pid( );
+        }
+    };
+
+    class c_replay_target : public c_target
+    {
+        static constexpr std::uint64_t page_size { 0x1000 }; ///< Granularity of the memory image
+
+        struct record_t
+        {
+            e_trace_op    op { e_trace_op::read }; ///< Recorded call
+            std::uint64_t start { 0 };             ///< Start of the call relative to the recording in nanoseconds
+            std::uint64_t duration { 0 };          ///< Time the call took in nanoseconds
+            std::uint64_t address { 0 };           ///< Address of a read, write or query
+            std::uint64_t size { 0 };              ///< Size of a read or write
+            std::uint64_t result { 0 };            ///< Bytes read, or whether a write succeeded
+
+            std::span< const std::uint8_t > bytes { }; ///< Bytes returned by a read or passed to a write
+
+            std::vector< record_t >   entries { }; ///< Reads of a batch
+            std::optional< region_t > region { };  ///< Result of a query
+            std::string               name { "" }; ///< Name passed to a module lookup
+            std::optional< module_t > module { };  ///< Result of a module lookup
+        };
+
+        struct page_t
+        {
+            std::array< std::uint8_t, page_size > bytes { }; ///< Last recorded contents of the page
+            std::bitset< page_size >              known { }; ///< Which bytes were ever recorded
+        };
+
+        c_mapping    m_mapping;            ///< Read-only mapping of the trace file
+        std::int32_t m_pid { 0 };          ///< Process ID of the recorded target
+        bool         m_realtime { false }; ///< Whether calls take as long as they did when recorded
+
+        std::vector< record_t >                          m_records { }; ///< Every record of the trace, in order
+        std::map< std::uint64_t, region_t >              m_regions { }; ///< Last recorded region per base address
+        std::unordered_map< std::string, module_t >      m_modules { }; ///< Last recorded module per name
+        std::unordered_map< std::string, std::uint64_t > m_notes { };   ///< Values attached with c_recording_target::note
+
+        mutable std::mutex                                  m_mutex { };    ///< Guards the replay state below
+        mutable std::size_t                                 m_cursor { 0 }; ///< Index of the next record expected
+        mutable std::unordered_map< std::uint64_t, page_t > m_image { };    ///< Memory as of the end of the recording
+        mutable std::set< std::uint64_t >                   m_pages { };    ///< Addresses of the pages in m_image, in order
+        mutable replay_stats_t                              m_stats { };    ///< Counters reported by stats()
+
+        std::array< std::uint64_t, trace::op_count > m_average { }; ///< Mean duration per op, used to pace diverged calls
+        std::chrono::steady_clock::time_point        m_clock { };   ///< When the replay started, the recorded schedule runs from it
+
+        mutable std::uint64_t m_position { 0 }; ///< End of the last matched call relative to the recording in nanoseconds
+        mutable std::uint64_t m_debt { 0 };     ///< Nanoseconds diverged calls added to the recorded schedule
+
+        /**
+         * @brief Parses the trace and builds the memory image.
+         *
+         * @return True if the header was valid. A truncated trace keeps the records parsed so far.
+         */
+        bool parse( ) noexcept;
+
+        /**
+         * @brief Copies bytes into the memory image.
+         */
+        void store( std::uint64_t address, std::span< const std::uint8_t > bytes ) const noexcept;
+
+        /**
+         * @brief Reads from the memory image, stopping at the first byte that was never recorded.
+         *
+         * @return The number of bytes read.
+         */
+        std::size_t load( std::uint64_t address, void *buffer, std::size_t size ) const noexcept;
+
+        /**
+         * @brief Finds the record of the current call at or shortly after the replay position.
+         *
+         * @param predicate Checks whether a record describes the current call.
+         *
+         * @return The record, with the replay position moved past it, or nullptr if the replay diverged.
+         */
+        const record_t *next( const std::function< bool( const record_t & ) > &predicate ) const noexcept;
+
+        /**
+         * @brief Sleeps until a call returned in the recording in realtime mode.
+         *
+         * Matched calls follow the recorded schedule against m_clock, so time spent between calls is not paid twice.
+         * A diverged call has no place on it, it pushes every later call back by the mean duration of its op.
+         */
+        void pace( e_trace_op op, const record_t *record ) const noexcept;
+
+      public:
+        /**
+         * @brief Loads a trace written by c_recording_target.
+         *
+         * Calls are served from the trace in order as long as they match it, which replays an unchanged
+         * build bit-exactly. Calls that do not match, e.g. from a different lookup strategy, are served
+         * from the memory image the trace accumulated.
+         *
+         * @param path The path of the trace file.
+         * @param realtime Whether every call should take as long as it did when it was recorded.
+         */
+        c_replay_target( const std::string &path, bool realtime = false ) noexcept;
+
+        [[nodiscard]] bool valid( ) const noexcept override;
+
+        std::size_t read( std::uint64_t address, void *buffer, std::size_t size ) const noexcept override;
+
+        void read_batch( std::span< read_request_t > requests ) const noexcept override;
+
+        bool write( std::uint64_t address, const void *buffer, std::size_t size ) const noexcept override;
+
+        [[nodiscard]] std::optional< region_t > query( std::uint64_t address ) const noexcept override;
+
+        [[nodiscard]] std::unique_ptr< module_t > module( const std::string &name ) const noexcept override;
+
+        [[nodiscard]] std::int32_t pid( ) const noexcept override
+        {
+            return m_pid;
+        }
+
+        using c_target::note;
+
+        /**
+         * @brief Returns a value attached to the trace while recording.
+         *
+         * @param key The name of the value.
+         *
+         * @return The value, or std::nullopt if the trace has none under this name.
+         */
+        [[nodiscard]] std::optional< std::uint64_t > note( const std::string &key ) const noexcept
+        {
+            const auto it = m_notes.find( key );
+            return it != m_notes.end( ) ? std::optional( it->second ) : std::nullopt;
+        }
+
+        /**
+         * @brief Returns the replay counters.
+         *
+         * @return A snapshot of the counters.
+         */
+        [[nodiscard]] replay_stats_t stats( ) const noexcept
+        {
+            std::scoped_lock lock( m_mutex );
+            return m_stats;
+        }
+    };
+} // namespace odessa
\ No newline at end of file
@@ -6,11 +6,14 @@
 // clang-format on
 
 #include <propvarutil.h>
-#include <execution>
-#include <map>
 #include <mfapi.h>
 #include <mfidl.h>
 #include <mfreadwrite.h>
+#include <shlobj.h>
+
+#include <execution>
+#include <list>
+#include <map>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -19,8 +22,12 @@
 #include <fstream>
 #include <print>
 #include <array>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <chrono>
+#include <coroutine>
 
-#include <shlobj.h>
 #include <filesystem>
 #include <variant>
 
@@ -94,4 +101,10 @@
 #if __cpp_impl_coroutine
 #include <coroutine>
 #endif
+#endif
+
+// SSE2 is part of every x64 target, the name matching and the heap scanner keep a scalar path for anything else
+#if defined( _M_X64 ) or defined( __SSE2__ )
+#include <emmintrin.h>
+#define ODESSA_SSE2
 #endif
\ No newline at end of file